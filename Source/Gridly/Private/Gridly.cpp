@@ -12,6 +12,9 @@
 #include "GridlyGameSettings.h"
 #endif
 
+#include "GridlyCultureConverter.h"
+#include "GridlyTask_DownloadLocalizedTexts.h"
+
 // For logging functionality
 #include "Logging/LogMacros.h"
 
@@ -25,6 +28,8 @@ DEFINE_LOG_CATEGORY(LogGridly);
 
 void FGridlyModule::StartupModule()
 {
+    FGridlyCultureConverter::Initialize();
+
 #if WITH_EDITOR
     // Register project settings
     if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
@@ -49,6 +54,9 @@ void FGridlyModule::StartupModule()
 
 void FGridlyModule::ShutdownModule()
 {
+    FGridlyCultureConverter::Shutdown();
+    UGridlyTask_DownloadLocalizedTexts::ReleasePool();
+
 #if WITH_EDITOR
     if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
     {
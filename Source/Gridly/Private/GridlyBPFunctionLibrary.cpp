@@ -2,6 +2,9 @@
 
 #include "GridlyBPFunctionLibrary.h"
 
+#include "GridlyRequestPacer.h"
+#include "GridlyTextRegistry.h"
+#include "GridlyTextStore.h"
 #include "Internationalization/Culture.h"
 #include "Internationalization/Internationalization.h"
 #include "Internationalization/PolyglotTextData.h"
@@ -23,8 +26,64 @@ void UGridlyBPFunctionLibrary::EnableLocalizationPreview(const FString& Culture)
 #endif
 }
 
+void UGridlyBPFunctionLibrary::DisableLocalizationPreview()
+{
+#if WITH_EDITOR
+	FTextLocalizationManager::Get().DisableGameLocalizationPreview();
+#endif
+
+	// The next update starts over and registers every text again
+	FGridlyTextRegistry::Reset();
+}
+
 void UGridlyBPFunctionLibrary::UpdateLocalizationPreview(const TArray<FPolyglotTextData>& PolyglotTextDatas)
 {
-	FTextLocalizationManager::Get().RegisterPolyglotTextData(PolyglotTextDatas);
+	// Registered texts stay registered, so only the texts that are new or have changed since the last update are registered again.
+	// Every registration bumps the text revision, which refreshes all texts, so an update without changes does nothing
+
+	TArray<FPolyglotTextData> ChangedPolyglotTextDatas;
+
+	for (const FPolyglotTextData& PolyglotTextData : PolyglotTextDatas)
+	{
+		if (FGridlyTextRegistry::Update(PolyglotTextData))
+		{
+			ChangedPolyglotTextDatas.Add(PolyglotTextData);
+		}
+	}
+
+	if (ChangedPolyglotTextDatas.Num() == 0)
+	{
+		return;
+	}
+
+	FTextLocalizationManager::Get().RegisterPolyglotTextData(ChangedPolyglotTextDatas);
 	EnableLocalizationPreview(GetLocalizationPreviewCulture());
 }
+
+void UGridlyBPFunctionLibrary::UpdateLocalizationPreview(const FGridlyTextStore& TextStore)
+{
+	// The store holds the hashes of every text, so unchanged texts are skipped without reading their strings
+
+	TArray<FPolyglotTextData> ChangedPolyglotTextDatas;
+
+	for (int32 Index = 0; Index < TextStore.Num(); Index++)
+	{
+		if (FGridlyTextRegistry::Update(TextStore.GetIdHash(Index), TextStore.GetContentHash(Index)))
+		{
+			ChangedPolyglotTextDatas.Add(TextStore.MakePolyglotTextData(Index));
+		}
+	}
+
+	if (ChangedPolyglotTextDatas.Num() == 0)
+	{
+		return;
+	}
+
+	FTextLocalizationManager::Get().RegisterPolyglotTextData(ChangedPolyglotTextDatas);
+	EnableLocalizationPreview(GetLocalizationPreviewCulture());
+}
+
+float UGridlyBPFunctionLibrary::GetRequestSendRate()
+{
+	return FGridlyRequestPacer::Get().GetCurrentSendRate();
+}
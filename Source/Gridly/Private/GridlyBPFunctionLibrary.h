@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 
+class FGridlyTextStore;
+
 #include "GridlyBPFunctionLibrary.generated.h"
 
 UCLASS()
@@ -19,6 +21,18 @@ public:
 	UFUNCTION(Category = Gridly, BlueprintCallable)
 	static void EnableLocalizationPreview(const FString& Culture);
 
+	/** Turns the preview off and forgets the registered texts, so the next update registers all of them again */
+	UFUNCTION(Category = Gridly, BlueprintCallable)
+	static void DisableLocalizationPreview();
+
+	/** Registers the texts that are new or have changed since the last update, and refreshes the preview if there were any */
 	UFUNCTION(Category = Gridly, BlueprintCallable)
 	static void UpdateLocalizationPreview(const TArray<FPolyglotTextData>& PolyglotTextDatas);
+
+	/** Same as above, but only the texts that changed are copied out of the store */
+	static void UpdateLocalizationPreview(const FGridlyTextStore& TextStore);
+
+	/** Returns the rate in requests per second Gridly requests are currently paced at, or 0 if they are not being throttled */
+	UFUNCTION(Category = Gridly, BlueprintPure)
+	static float GetRequestSendRate();
 };
@@ -0,0 +1,199 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyLiveUpdateSubsystem.h"
+
+#include "Async/Async.h"
+#include "Gridly.h"
+#include "GridlyGameSettings.h"
+#include "GridlyLocalizedTextConverter.h"
+#include "GridlyResult.h"
+#include "GridlyTask_DownloadLocalizedTexts.h"
+#include "GridlyTextRegistry.h"
+#include "Internationalization/TextLocalizationManager.h"
+#include "Tasks/Task.h"
+
+namespace GridlyLiveUpdate
+{
+	// Texts registered in the first frame, before the cost of a registration has been measured, and the least in any frame
+	constexpr int32 MinTextsPerFrame = 32;
+}
+
+bool UGridlyLiveUpdateSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return GetDefault<UGridlyGameSettings>()->bEnableLiveUpdate && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UGridlyLiveUpdateSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UGridlyGameSettings* GameSettings = GetDefault<UGridlyGameSettings>();
+	FrameBudgetSeconds = GameSettings->LiveUpdateFrameBudgetMs / 1000.f;
+	TextsPerFrame = GridlyLiveUpdate::MinTextsPerFrame;
+
+	TickerHandles.Add(FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this,
+		&UGridlyLiveUpdateSubsystem::Poll), GameSettings->LiveUpdateInterval));
+	TickerHandles.Add(FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this,
+		&UGridlyLiveUpdateSubsystem::ApplyPendingTexts)));
+
+	UE_LOG(LogGridly, Log, TEXT("Live update enabled, polling every %.0f seconds"), GameSettings->LiveUpdateInterval);
+
+	RefreshNow();
+}
+
+void UGridlyLiveUpdateSubsystem::Deinitialize()
+{
+	for (const FTSTicker::FDelegateHandle& TickerHandle : TickerHandles)
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+	TickerHandles.Reset();
+
+	if (DownloadTask)
+	{
+		DownloadTask->Cancel();
+		DownloadTask = nullptr;
+	}
+
+	// Pages still being compared on worker threads are dropped when they report back
+	RunSerial++;
+	PagesInFlight = 0;
+	PendingTexts.Empty();
+	PendingHashes.Empty();
+	PendingIndex = 0;
+
+	Super::Deinitialize();
+}
+
+void UGridlyLiveUpdateSubsystem::RefreshNow()
+{
+	if (IsUpdating())
+	{
+		return;
+	}
+
+	DownloadTask = UGridlyTask_DownloadLocalizedTexts::DownloadLocalizedTextsPooled(GetGameInstance(), false);
+	DownloadTask->OnProgressDelegate.BindUObject(this, &UGridlyLiveUpdateSubsystem::OnPageDownloaded);
+	DownloadTask->OnSuccessDelegate.BindUObject(this, &UGridlyLiveUpdateSubsystem::OnDownloadSucceeded);
+	DownloadTask->OnFailDelegate.BindUObject(this, &UGridlyLiveUpdateSubsystem::OnDownloadFailed);
+	DownloadTask->Activate();
+}
+
+int UGridlyLiveUpdateSubsystem::GetPendingCount() const
+{
+	return PendingTexts.Num() - PendingIndex;
+}
+
+bool UGridlyLiveUpdateSubsystem::Poll(float DeltaTime)
+{
+	RefreshNow();
+	return true;
+}
+
+bool UGridlyLiveUpdateSubsystem::IsUpdating() const
+{
+	// The next download waits until the previous one has been applied, so a slow frame rate can't queue up work
+	return DownloadTask != nullptr || PagesInFlight > 0 || GetPendingCount() > 0;
+}
+
+void UGridlyLiveUpdateSubsystem::OnPageDownloaded(const TArray<FPolyglotTextData>& PageTexts, float Progress)
+{
+	if (PageTexts.Num() == 0)
+	{
+		return;
+	}
+
+	PagesInFlight++;
+
+	TWeakObjectPtr<UGridlyLiveUpdateSubsystem> WeakThis(this);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Serial = RunSerial, PageTexts]() mutable
+	{
+		// Texts seen for the first time are applied too, the localization manager may only have the shipped ones.
+		// The registry is shared with UpdateLocalizationPreview, so a text it has reverted is applied again. It is only
+		// updated once the texts have been registered, so texts dropped before that are applied by the next update
+		TArray<FPolyglotTextData> ChangedTexts;
+		TArray<TPair<uint64, uint64>> ChangedHashes;
+		for (FPolyglotTextData& PolyglotTextData : PageTexts)
+		{
+			const uint64 IdHash = FGridlyLocalizedTextConverter::HashTextId(PolyglotTextData.GetNamespace(), PolyglotTextData.GetKey());
+			const uint64 ContentHash = FGridlyLocalizedTextConverter::HashPolyglotTextData(PolyglotTextData);
+			if (FGridlyTextRegistry::IsChanged(IdHash, ContentHash))
+			{
+				ChangedTexts.Add(MoveTemp(PolyglotTextData));
+				ChangedHashes.Emplace(IdHash, ContentHash);
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, ChangedTexts = MoveTemp(ChangedTexts),
+			ChangedHashes = MoveTemp(ChangedHashes)]() mutable
+		{
+			if (UGridlyLiveUpdateSubsystem* Subsystem = WeakThis.Get(); Subsystem && Subsystem->RunSerial == Serial)
+			{
+				Subsystem->PagesInFlight--;
+				Subsystem->PendingTexts.Append(MoveTemp(ChangedTexts));
+				Subsystem->PendingHashes.Append(MoveTemp(ChangedHashes));
+			}
+		});
+	});
+}
+
+void UGridlyLiveUpdateSubsystem::OnDownloadSucceeded(const TArray<FPolyglotTextData>& PolyglotTextDatas)
+{
+	// The task goes back to the pool once this returns
+	DownloadTask = nullptr;
+}
+
+void UGridlyLiveUpdateSubsystem::OnDownloadFailed(const TArray<FPolyglotTextData>& PolyglotTextDatas, const FGridlyResult& Result)
+{
+	DownloadTask = nullptr;
+
+	if (!Result.bCancelled)
+	{
+		UE_LOG(LogGridly, Warning, TEXT("Live update download failed, retrying on the next poll: %s"), *Result.Message);
+	}
+}
+
+bool UGridlyLiveUpdateSubsystem::ApplyPendingTexts(float DeltaTime)
+{
+	if (GetPendingCount() == 0)
+	{
+		return true;
+	}
+
+	// Every registration bumps the text revision and refreshes every text, so the texts of a frame are registered with a
+	// single call. The budget decides how many texts go into it, from the time the last call took per text
+
+	const int NumTexts = FMath::Min(TextsPerFrame, GetPendingCount());
+
+	const double StartTime = FPlatformTime::Seconds();
+	FTextLocalizationManager::Get().RegisterPolyglotTextData(MakeArrayView(PendingTexts.GetData() + PendingIndex, NumTexts));
+	const double RegisterTime = FPlatformTime::Seconds() - StartTime;
+
+	for (int i = PendingIndex; i < PendingIndex + NumTexts; i++)
+	{
+		FGridlyTextRegistry::Update(PendingHashes[i].Key, PendingHashes[i].Value);
+	}
+	PendingIndex += NumTexts;
+	AppliedCount += NumTexts;
+
+	// Grows at most twofold per frame, so a fast frame can't lead to a long one. At least MinTextsPerFrame are applied, so the
+	// queue drains even with a tiny budget
+	const int BudgetTexts = RegisterTime > 0.0 ? FMath::FloorToInt(NumTexts * FrameBudgetSeconds / RegisterTime) : NumTexts * 2;
+	TextsPerFrame = FMath::Clamp(BudgetTexts, GridlyLiveUpdate::MinTextsPerFrame,
+		FMath::Max(NumTexts, GridlyLiveUpdate::MinTextsPerFrame) * 2);
+
+	if (GetPendingCount() == 0)
+	{
+		PendingTexts.Reset();
+		PendingHashes.Reset();
+		PendingIndex = 0;
+
+		if (!DownloadTask && PagesInFlight == 0)
+		{
+			UE_LOG(LogGridly, Log, TEXT("Live update applied %d changed texts"), AppliedCount);
+			AppliedCount = 0;
+		}
+	}
+
+	return true;
+}
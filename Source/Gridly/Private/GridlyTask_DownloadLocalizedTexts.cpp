@@ -2,123 +2,383 @@
 
 #include "GridlyTask_DownloadLocalizedTexts.h"
 
-#include "Engine/EngineTypes.h"
-#include "Engine/World.h"
-#include "TimerManager.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
 #include "Gridly.h"
+#include "GridlyBPFunctionLibrary.h"
+#include "GridlyCultureConverter.h"
 #include "GridlyGameSettings.h"
 #include "GridlyLocalizedTextConverter.h"
+#include "GridlyRequestPacer.h"
 #include "GridlyTableRow.h"
+#include "GridlyTextCache.h"
+#include "GridlyViewCache.h"
 #include "HttpModule.h"
 #include "JsonObjectConverter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tasks/Task.h"
 #include "GenericPlatform/GenericPlatformHttp.h"
 #include "Runtime/Online/HTTP/Public/Interfaces/IHttpResponse.h"
 
-UGridlyTask_DownloadLocalizedTexts::UGridlyTask_DownloadLocalizedTexts()
+static bool LoadCachedPageTexts(const FString& ViewId, const int Offset, const int Limit, const FString& ConversionKey,
+	TArray<FPolyglotTextData>& OutPageTexts)
 {
-	if (!HasAnyFlags(RF_ClassDefaultObject))
+	FGridlyCachedPage CachedPage;
+	if (FGridlyViewCache::LoadPage(ViewId, Offset, Limit, ConversionKey, CachedPage))
 	{
-		AddToRoot();
+		FMemoryReader Reader(CachedPage.Payload);
+		FGridlyLocalizedTextConverter::SerializePolyglotTextDatas(Reader, OutPageTexts);
+		return !Reader.IsError();
 	}
+
+	return false;
+}
+
+/** Finished tasks kept for reuse. Pooled tasks stay rooted and have released their buffers */
+static TArray<UGridlyTask_DownloadLocalizedTexts*> DownloadTaskPool;
+
+// Set once the offline text cache has been applied in this launch
+static bool bAppliedTextCache = false;
+
+UGridlyTask_DownloadLocalizedTexts::UGridlyTask_DownloadLocalizedTexts()
+{
 }
 
 void UGridlyTask_DownloadLocalizedTexts::Activate()
 {
-	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+	// Worker threads read the settings while converting pages, so they get a copy that can't change under them
+	Settings = FGridlySettingsSnapshot::Capture();
+	const FGridlySettingsSnapshot& GameSettings = *Settings;
+
+	// Kept alive until the download has finished, see Finish()
+	if (!IsRooted())
+	{
+		AddToRoot();
+	}
 
-	Limit = GameSettings->ImportMaxRecordsPerRequest;
+	// Callbacks still in flight from an earlier run of a pooled task are ignored
+	RunSerial++;
+
+	Limit = GameSettings.ImportMaxRecordsPerRequest;
+	MaxConcurrentRequests = FMath::Max(1, GameSettings.ImportMaxConcurrentRequests);
+	MaxRetries = FMath::Max(0, GameSettings.ImportMaxRetriesPerPage);
+	RetryBaseDelay = GameSettings.ImportRetryBaseDelay;
 	TotalCount = 0;
+	ReceivedCount = 0;
 
 	ViewIds.Reset();
-	for (int i = 0; i < GameSettings->ImportFromViewIds.Num(); i++)
+	for (int i = 0; i < GameSettings.ImportFromViewIds.Num(); i++)
 	{
-		if (!GameSettings->ImportFromViewIds[i].IsEmpty())
+		if (!GameSettings.ImportFromViewIds[i].IsEmpty())
 		{
-			ViewIds.Add(GameSettings->ImportFromViewIds[i]);
+			ViewIds.Add(GameSettings.ImportFromViewIds[i]);
 		}
 	}
 
 	PolyglotTextDatas.Reset();
 
-	RequestPage(0, 0);
-}
+	// Resolved up front since the conversion runs on worker threads
+	TargetCultures = FGridlyCultureConverter::GetTargetCultures();
+	ConversionKey = FGridlyLocalizedTextConverter::GetConversionKey(GameSettings, TargetCultures);
 
-void UGridlyTask_DownloadLocalizedTexts::RequestPage(const int ViewIdIndex, const int Offset)
-{
-	CurrentViewIdIndex = ViewIdIndex;
-	CurrentOffset = Offset;
+	ColumnIdsQuery.Reset();
+	TArray<FString> ColumnIds;
+	if (GameSettings.bImportOnlyUsedColumns && FGridlyLocalizedTextConverter::GetImportColumnIds(GameSettings, TargetCultures, ColumnIds))
+	{
+		ColumnIdsQuery = FGenericPlatformHttp::UrlEncode(FString::Join(ColumnIds, TEXT(",")));
+	}
+	bUseCache = GameSettings.bCacheImportedPages;
+	bIsRunning = true;
+
+	// Only downloads started by the game have a world context, the editor and commandlet import to the project instead
+	bUseTextCache = GameSettings.bUseOfflineTextCache && WorldContextObject != nullptr;
 
 	if (ViewIds.Num() == 0)
 	{
 		const FGridlyResult FailResult = FGridlyResult{"Unable to import texts: no view IDs were specified"};
 		UE_LOG(LogGridly, Error, TEXT("%s"), *FailResult.Message);
-		OnFail.Broadcast(PolyglotTextDatas, 1.f, FailResult);
-		if (OnFailDelegate.IsBound())
-			OnFailDelegate.Execute(PolyglotTextDatas, FailResult);
+		Fail(FailResult);
 		return;
 	}
 
+	if (bUseTextCache && !bAppliedTextCache)
+	{
+		ApplyTextCache();
+	}
+
+	RequestView(0);
+}
+
+void UGridlyTask_DownloadLocalizedTexts::ApplyTextCache()
+{
+	// Once per launch, later downloads start from the texts of the earlier ones
+	bAppliedTextCache = true;
+
+	// The texts are registered straight from the mapped file, the store is closed once they have been
+	const TSharedPtr<const FGridlyTextStore, ESPMode::ThreadSafe> TextStore =
+		FGridlyTextCache::Open(FGridlyTextCache::GetCacheKey(ViewIds, ConversionKey));
+	if (TextStore.IsValid())
+	{
+		UE_LOG(LogGridly, Log, TEXT("Applying %d cached texts while downloading"), TextStore->Num());
+		UGridlyBPFunctionLibrary::UpdateLocalizationPreview(*TextStore);
+	}
+}
+
+void UGridlyTask_DownloadLocalizedTexts::RequestView(const int ViewIdIndex)
+{
+	CurrentViewIdIndex = ViewIdIndex;
+
+	ViewPages.Reset();
+	PendingOffsets.Reset();
+	CachedPages.Reset();
+	RetryAttempts.Reset();
+	ThrottledAttempts.Reset();
+	ReceivedPages = 0;
+
 	if (ViewIdIndex < ViewIds.Num())
 	{
-		const FString& ViewId = ViewIds[ViewIdIndex];
+		// The first page tells us the total count, the remaining pages are fanned out once it arrives
+		RequestPage(ViewIdIndex, 0);
+	}
+	else
+	{
+		bIsRunning = false;
+		OnSuccess.Broadcast(PolyglotTextDatas, 1.f, FGridlyResult::Success);
+		if (OnSuccessDelegate.IsBound())
+			OnSuccessDelegate.Execute(PolyglotTextDatas);
+
+		// Finish() would release the texts anyway, so they are handed to the cache instead of copied. Without bKeepResult
+		// there is no complete set of texts to save
+		if (bUseTextCache && bKeepResult)
+		{
+			FGridlyTextCache::SaveAsync(FGridlyTextCache::GetCacheKey(ViewIds, ConversionKey), MoveTemp(PolyglotTextDatas));
+		}
+
+		Finish();
+	}
+}
+
+void UGridlyTask_DownloadLocalizedTexts::RequestPage(const int ViewIdIndex, const int Offset)
+{
+	const FString& ViewId = ViewIds[ViewIdIndex];
+
+	const FString ApiKey = Settings->ImportApiKey;
 
-		const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
-		const FString ApiKey = GameSettings->ImportApiKey;
+	const FString PaginationSettings =
+		FGenericPlatformHttp::UrlEncode(FString::Printf(TEXT("{\"offset\":%d,\"limit\":%d}"), Offset, Limit));
 
-		const FString PaginationSettings =
-			FGenericPlatformHttp::UrlEncode(FString::Printf(TEXT("{\"offset\":%d,\"limit\":%d}"), Offset, Limit));
+	FStringFormatNamedArguments Args;
+	Args.Add(TEXT("ViewId"), *ViewId);
+	Args.Add(TEXT("PaginationSettings"), *PaginationSettings);
+	FString Url = FString::Format(TEXT("https://api.gridly.com/v1/views/{ViewId}/records?page={PaginationSettings}"), Args);
+	if (!ColumnIdsQuery.IsEmpty())
+	{
+		Url += TEXT("&columnIds=") + ColumnIdsQuery;
+	}
 
-		FStringFormatNamedArguments Args;
-		Args.Add(TEXT("ViewId"), *ViewId);
-		Args.Add(TEXT("PaginationSettings"), *PaginationSettings);
-		const FString Url = FString::Format(TEXT("https://api.gridly.com/v1/views/{ViewId}/records?page={PaginationSettings}"),
-			Args);
+	const FHttpRequestPtr HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("ApiKey %s"), *ApiKey));
 
-		HttpRequest = FHttpModule::Get().CreateRequest();
-		HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
-		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-		HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("ApiKey %s"), *ApiKey));
+	HttpRequest->SetVerb(TEXT("GET"));
+	HttpRequest->SetURL(Url);
 
-		HttpRequest->SetVerb(TEXT("GET"));
-		HttpRequest->SetURL(Url);
+	if (bUseCache)
+	{
+		FGridlyCachedPage CachedPage;
+		if (FGridlyViewCache::LoadValidators(ViewId, Offset, Limit, ConversionKey, CachedPage))
+		{
+			// The first page also tells the size of the view. A 304 for it doesn't mean no rows were added further on, so it
+			// is always downloaded, and only skips the parsing when its content hash matches
+			if (Offset > 0)
+			{
+				FGridlyViewCache::AddConditionalHeaders(HttpRequest, CachedPage);
+			}
+			CachedPages.Add(Offset, MoveTemp(CachedPage));
+		}
+	}
 
-		HttpRequest->OnProcessRequestComplete().BindUObject(this, &UGridlyTask_DownloadLocalizedTexts::OnProcessRequestComplete);
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UGridlyTask_DownloadLocalizedTexts::OnProcessRequestComplete,
+		Offset);
 
-		OnProgress.Broadcast(PolyglotTextDatas, .1f, FGridlyResult::Success);
-		if (OnProgressDelegate.IsBound())
-			OnProgressDelegate.Execute(PolyglotTextDatas, .1f);
+	ActiveRequests.Add(Offset, HttpRequest);
 
-		// Throttles number of requests by sleeping between each
+	// Sends right away unless Gridly has asked us to slow down
 
-		UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
-		if (World)
+	const double SendDelay = FGridlyRequestPacer::Get().ReserveSendDelay();
+	if (SendDelay > 0.0)
+	{
+		TickerHandles.Add(FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this,
+			[this, HttpRequest, ViewId, Offset, Serial = RunSerial](float)
 		{
-			FTimerHandle TimerHandle;
-			World->GetTimerManager().SetTimer(TimerHandle, [this, ViewId, Offset]()
+			if (RunSerial == Serial && bIsRunning)
 			{
 				HttpRequest->ProcessRequest();
 				UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
-			}, 1.f, false);
-		}
-		else
+			}
+			return false;
+		}), SendDelay));
+	}
+	else
+	{
+		HttpRequest->ProcessRequest();
+		UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
+	}
+}
+
+void UGridlyTask_DownloadLocalizedTexts::QueueViewPages(const int ViewIdTotalCount)
+{
+	// Now that the size of the view is known, queue up the remaining pages
+
+	TotalCount += ViewIdTotalCount;
+
+	const int NumPages = FMath::Max(1, FMath::DivideAndRoundUp(ViewIdTotalCount, Limit));
+	ViewPages.SetNum(NumPages);
+	for (int PageOffset = Limit; PageOffset < ViewIdTotalCount; PageOffset += Limit)
+	{
+		PendingOffsets.Add(PageOffset);
+	}
+}
+
+bool UGridlyTask_DownloadLocalizedTexts::RetryPage(const int Offset)
+{
+	int& Attempts = RetryAttempts.FindOrAdd(Offset);
+	if (Attempts >= MaxRetries)
+	{
+		return false;
+	}
+
+	Attempts++;
+
+	const double RetryDelay = FGridlyRequestPacer::GetRetryDelay(Attempts, RetryBaseDelay);
+	UE_LOG(LogGridly, Warning, TEXT("Failed to download offset %d of view ID: %s, retrying in %.1f s (%d/%d)"), Offset,
+		*ViewIds[CurrentViewIdIndex], RetryDelay, Attempts, MaxRetries);
+
+	TickerHandles.Add(FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, Offset, Serial = RunSerial](float)
+	{
+		if (RunSerial == Serial && bIsRunning)
 		{
-			HttpRequest->ProcessRequest();
-			UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
-			FPlatformProcess::Sleep(1.f);
+			PendingOffsets.Insert(Offset, 0);
+			RequestPendingPages();
 		}
+		return false;
+	}), RetryDelay));
+
+	return true;
+}
+
+void UGridlyTask_DownloadLocalizedTexts::RequestPendingPages()
+{
+	while (PendingOffsets.Num() > 0 && ActiveRequests.Num() < MaxConcurrentRequests)
+	{
+		const int Offset = PendingOffsets[0];
+		PendingOffsets.RemoveAt(0);
+		RequestPage(CurrentViewIdIndex, Offset);
+	}
+}
+
+void UGridlyTask_DownloadLocalizedTexts::CancelActiveRequests()
+{
+	for (const TPair<int, FHttpRequestPtr>& Pair : ActiveRequests)
+	{
+		Pair.Value->OnProcessRequestComplete().Unbind();
+		Pair.Value->CancelRequest();
+	}
+
+	ActiveRequests.Reset();
+	PendingOffsets.Reset();
+
+	for (const FTSTicker::FDelegateHandle& TickerHandle : TickerHandles)
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+	TickerHandles.Reset();
+}
+
+void UGridlyTask_DownloadLocalizedTexts::Cancel()
+{
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	UE_LOG(LogGridly, Log, TEXT("Cancelled downloading localized texts"));
+
+	// Pages still being converted on worker threads are dropped when they report back
+	RunSerial++;
+
+	Fail(FGridlyResult::Cancelled);
+}
+
+void UGridlyTask_DownloadLocalizedTexts::Fail(const FGridlyResult& FailResult)
+{
+	bIsRunning = false;
+	CancelActiveRequests();
+
+	OnFail.Broadcast(PolyglotTextDatas, 1.f, FailResult);
+	if (OnFailDelegate.IsBound())
+		OnFailDelegate.Execute(PolyglotTextDatas, FailResult);
+
+	Finish();
+}
+
+void UGridlyTask_DownloadLocalizedTexts::Finish()
+{
+	bIsRunning = false;
+	CancelActiveRequests();
+
+	// The listeners have been given the texts already
+	PolyglotTextDatas.Empty();
+	ViewPages.Empty();
+	CachedPages.Empty();
+	RetryAttempts.Empty();
+	ThrottledAttempts.Empty();
+	TargetCultures.Empty();
+
+	SetReadyToDestroy();
+
+	const int PoolSize = Settings.IsValid() ? Settings->ImportTaskPoolSize : GetDefault<UGridlyGameSettings>()->ImportTaskPoolSize;
+	Settings.Reset();
+	if (bPooled && DownloadTaskPool.Num() < PoolSize && !DownloadTaskPool.Contains(this))
+	{
+		DownloadTaskPool.Add(this);
 	}
 	else
 	{
-		OnSuccess.Broadcast(PolyglotTextDatas, 1.f, FGridlyResult::Success);
-		if (OnSuccessDelegate.IsBound())
-			OnSuccessDelegate.Execute(PolyglotTextDatas);
+		RemoveFromRoot();
 	}
 }
 
 void UGridlyTask_DownloadLocalizedTexts::OnProcessRequestComplete(FHttpRequestPtr HttpRequestPtr,
-	FHttpResponsePtr HttpResponsePtr, bool bSuccess)
+	FHttpResponsePtr HttpResponsePtr, bool bSuccess, int Offset)
 {
-	if (bSuccess && HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok)
+	ActiveRequests.Remove(Offset);
+
+	if (FGridlyRequestPacer::Get().OnResponse(HttpResponsePtr))
+	{
+		int& Attempts = ThrottledAttempts.FindOrAdd(Offset);
+		if (++Attempts > FGridlyRequestPacer::MaxThrottledAttempts)
+		{
+			const FGridlyResult FailResult = FGridlyResult{FString::Printf(
+				TEXT("Failed to download offset %d of view ID: %s, the server kept throttling the requests"), Offset,
+				*ViewIds[CurrentViewIdIndex])};
+			UE_LOG(LogGridly, Error, TEXT("%s"), *FailResult.Message);
+			Fail(FailResult);
+			return;
+		}
+
+		// Throttled, try this page again once the pacer allows it
+		PendingOffsets.Insert(Offset, 0);
+		RequestPendingPages();
+		return;
+	}
+
+	const FGridlyCachedPage* CachedPage = CachedPages.Find(Offset);
+	const bool bNotModified = bSuccess && CachedPage && HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::NotModified;
+
+	if (bSuccess && (HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok || bNotModified))
 	{
 		// Header
 
@@ -128,61 +388,209 @@ void UGridlyTask_DownloadLocalizedTexts::OnProcessRequestComplete(FHttpRequestPt
 			UE_LOG(LogGridly, Verbose, TEXT("%s"), *Headers[i]);
 		}
 
-		// Convert from JSON to texts
+		if (Offset == 0 && ViewPages.Num() == 0)
+		{
+			const FString TotalCountHeader = HttpResponsePtr->GetHeader(TEXT("X-Total-Count"));
+			QueueViewPages(bNotModified && TotalCountHeader.IsEmpty()
+				               ? CachedPage->TotalCount
+				               : FCString::Atoi(*TotalCountHeader));
+		}
+
+		// Keep the network busy while this page is being converted
 
-		const FString Content = HttpResponsePtr->GetContentAsString();
-		UE_LOG(LogGridly, Verbose, TEXT("%s"), *Content);
+		RequestPendingPages();
 
-		TMap<FString, FPolyglotTextData> PolyglotTextDataMap;
-		TArray<FGridlyTableRow> TableRows;
+		// Convert from JSON to texts on a worker thread, only the merge happens on the game thread
 
-		if (FJsonObjectConverter::JsonArrayStringToUStruct(Content, &TableRows, 0, 0)
-		    && FGridlyLocalizedTextConverter::TableRowsToPolyglotTextDatas(TableRows, PolyglotTextDataMap))
+		const FString ViewId = ViewIds[CurrentViewIdIndex];
+		const FString CachedContentHash = CachedPage ? CachedPage->ContentHash : FString();
+
+		TWeakObjectPtr<UGridlyTask_DownloadLocalizedTexts> WeakThis(this);
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Serial = RunSerial, HttpResponsePtr, SettingsSnapshot = Settings.ToSharedRef(),
+			Cultures = TargetCultures,
+			CacheKey = ConversionKey, ViewId, Offset, PageLimit = Limit, bCachePage = bUseCache, bNotModified, CachedContentHash]()
 		{
-			TArray<FPolyglotTextData> CurrentPolyglotTextDatas;
-			PolyglotTextDataMap.GenerateValueArray(CurrentPolyglotTextDatas);
-			PolyglotTextDatas.Append(CurrentPolyglotTextDatas);
-
-			const int ViewIdTotalCount = FCString::Atoi(*HttpResponsePtr->GetHeader("X-Total-Count"));
-			TotalCount += CurrentOffset == 0 ? ViewIdTotalCount : 0;
-			const float EstimatedProgressViewIds =
-				static_cast<float>(CurrentViewIdIndex) / static_cast<float>(FMath::Max(1, ViewIds.Num()));
-			const float EstimatedProgressPagination = static_cast<float>(PolyglotTextDatas.Num()) / static_cast<float>(TotalCount);
-			const float EstimatedProgress = (EstimatedProgressViewIds + EstimatedProgressPagination) / 2.f;
-			
-			OnProgress.Broadcast(PolyglotTextDatas, EstimatedProgress, FGridlyResult::Success);
-			if (OnProgressDelegate.IsBound())
-				OnProgressDelegate.Execute(PolyglotTextDatas, EstimatedProgress);
-
-			if ((CurrentOffset + Limit) < TotalCount)
+			TArray<FPolyglotTextData> PageTexts;
+			bool bConverted = false;
+			bool bFromCache = false;
+
+			FGridlyCachedPage Page;
+			if (!bNotModified)
 			{
-				RequestPage(CurrentViewIdIndex, CurrentOffset + Limit);
+				FGridlyViewCache::ReadValidators(HttpResponsePtr, Page);
 			}
-			else
+
+			// Unchanged pages are taken from the cache without parsing
+
+			if (bNotModified || (!CachedContentHash.IsEmpty() && Page.ContentHash == CachedContentHash))
 			{
-				RequestPage(CurrentViewIdIndex + 1, 0);
+				bConverted = bFromCache = LoadCachedPageTexts(ViewId, Offset, PageLimit, CacheKey, PageTexts);
 			}
-		}
-		else
+
+			if (!bFromCache && !bNotModified)
+			{
+				const FString Content = HttpResponsePtr->GetContentAsString();
+				UE_LOG(LogGridly, Verbose, TEXT("%s"), *Content);
+
+				TMap<FString, FPolyglotTextData> PolyglotTextDataMap;
+				TArray<FGridlyTableRow> TableRows;
+
+				bConverted = FJsonObjectConverter::JsonArrayStringToUStruct(Content, &TableRows, 0, 0)
+				             && FGridlyLocalizedTextConverter::TableRowsToPolyglotTextDatas(TableRows, *SettingsSnapshot, Cultures,
+					             PolyglotTextDataMap);
+				if (bConverted)
+				{
+					PolyglotTextDataMap.GenerateValueArray(PageTexts);
+
+					if (bCachePage)
+					{
+						FMemoryWriter Writer(Page.Payload);
+						FGridlyLocalizedTextConverter::SerializePolyglotTextDatas(Writer, PageTexts);
+						FGridlyViewCache::SavePage(ViewId, Offset, PageLimit, CacheKey, Page);
+					}
+				}
+			}
+
+			// The server said the page is unchanged, but the cached copy is gone or unreadable
+			const bool bCacheMiss = bNotModified && !bFromCache;
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Offset, bConverted, bCacheMiss, PageTexts = MoveTemp(PageTexts)]() mutable
+			{
+				if (UGridlyTask_DownloadLocalizedTexts* Task = WeakThis.Get(); Task && Task->RunSerial == Serial)
+				{
+					Task->OnPageConverted(Offset, bConverted, bCacheMiss, MoveTemp(PageTexts));
+				}
+			});
+		});
+	}
+	else if (!FGridlyRequestPacer::IsRetryable(bSuccess, HttpResponsePtr) || !RetryPage(Offset))
+	{
+		Fail(FGridlyResult{"Failed to connect to Gridly"});
+	}
+}
+
+void UGridlyTask_DownloadLocalizedTexts::OnPageConverted(const int Offset, const bool bConverted, const bool bCacheMiss,
+	TArray<FPolyglotTextData>&& PageTexts)
+{
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	if (bCacheMiss)
+	{
+		// Download the page again, this time without validators
+
+		FGridlyViewCache::RemovePage(ViewIds[CurrentViewIdIndex], Offset, Limit);
+		CachedPages.Remove(Offset);
+		PendingOffsets.Insert(Offset, 0);
+		RequestPendingPages();
+		return;
+	}
+
+	if (!bConverted)
+	{
+		Fail(FGridlyResult{"Failed to parse downloaded content"});
+		return;
+	}
+
+	ReceivedCount += PageTexts.Num();
+	ReceivedPages++;
+
+	const float EstimatedProgressViewIds =
+		static_cast<float>(CurrentViewIdIndex) / static_cast<float>(FMath::Max(1, ViewIds.Num()));
+	const float EstimatedProgressPagination = static_cast<float>(ReceivedCount) / static_cast<float>(FMath::Max(1, TotalCount));
+	const float EstimatedProgress = (EstimatedProgressViewIds + EstimatedProgressPagination) / 2.f;
+
+	// Only the texts of this page are passed on, the accumulated result is kept for OnSuccess
+
+	OnProgress.Broadcast(PageTexts, EstimatedProgress, FGridlyResult::Success);
+	if (OnProgressDelegate.IsBound())
+		OnProgressDelegate.Execute(PageTexts, EstimatedProgress);
+
+	// A listener may have cancelled the download
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	const int PageIndex = Offset / Limit;
+	if (bKeepResult && ViewPages.IsValidIndex(PageIndex))
+	{
+		ViewPages[PageIndex] = MoveTemp(PageTexts);
+	}
+
+	if (ReceivedPages >= ViewPages.Num())
+	{
+		// All pages of this view have arrived, merge them in order and move on
+
+		for (int i = 0; i < ViewPages.Num(); i++)
 		{
-			const FGridlyResult FailResult = FGridlyResult{"Failed to parse downloaded content"};
-			OnFail.Broadcast(PolyglotTextDatas, 1.f, FailResult);
-			if (OnFailDelegate.IsBound())
-				OnFailDelegate.Execute(PolyglotTextDatas, FailResult);
+			PolyglotTextDatas.Append(MoveTemp(ViewPages[i]));
 		}
+
+		RequestView(CurrentViewIdIndex + 1);
+	}
+}
+
+int UGridlyTask_DownloadLocalizedTexts::GetReceivedCount() const
+{
+	return ReceivedCount;
+}
+
+int UGridlyTask_DownloadLocalizedTexts::GetTotalCount() const
+{
+	return TotalCount;
+}
+
+UGridlyTask_DownloadLocalizedTexts* UGridlyTask_DownloadLocalizedTexts::DownloadLocalizedTexts(const UObject* WorldContextObject,
+	bool bKeepResult)
+{
+	// Blueprint may keep the task and call Cancel() or the getters on it later, so it never gets one that can be reused
+	UGridlyTask_DownloadLocalizedTexts* DownloadLocalizedTexts = NewObject<UGridlyTask_DownloadLocalizedTexts>();
+	DownloadLocalizedTexts->WorldContextObject = WorldContextObject;
+	DownloadLocalizedTexts->bKeepResult = bKeepResult;
+	DownloadLocalizedTexts->bPooled = false;
+	return DownloadLocalizedTexts;
+}
+
+UGridlyTask_DownloadLocalizedTexts* UGridlyTask_DownloadLocalizedTexts::DownloadLocalizedTextsPooled(const UObject* WorldContextObject,
+	bool bKeepResult)
+{
+	UGridlyTask_DownloadLocalizedTexts* DownloadLocalizedTexts = nullptr;
+	if (DownloadTaskPool.Num() > 0)
+	{
+		DownloadLocalizedTexts = DownloadTaskPool.Pop(EAllowShrinking::No);
+
+		// Listeners of the previous run must not hear about this one
+		DownloadLocalizedTexts->OnSuccess.Clear();
+		DownloadLocalizedTexts->OnProgress.Clear();
+		DownloadLocalizedTexts->OnFail.Clear();
+		DownloadLocalizedTexts->OnSuccessDelegate.Unbind();
+		DownloadLocalizedTexts->OnProgressDelegate.Unbind();
+		DownloadLocalizedTexts->OnFailDelegate.Unbind();
 	}
 	else
 	{
-		const FGridlyResult FailResult = FGridlyResult{"Failed to connect to Gridly"};
-		OnFail.Broadcast(PolyglotTextDatas, 1.f, FailResult);
-		if (OnFailDelegate.IsBound())
-			OnFailDelegate.Execute(PolyglotTextDatas, FailResult);
+		DownloadLocalizedTexts = NewObject<UGridlyTask_DownloadLocalizedTexts>();
 	}
-}
 
-UGridlyTask_DownloadLocalizedTexts* UGridlyTask_DownloadLocalizedTexts::DownloadLocalizedTexts(const UObject* WorldContextObject)
-{
-	const auto DownloadLocalizedTexts = NewObject<UGridlyTask_DownloadLocalizedTexts>();
 	DownloadLocalizedTexts->WorldContextObject = WorldContextObject;
+	DownloadLocalizedTexts->bKeepResult = bKeepResult;
+	DownloadLocalizedTexts->bPooled = true;
 	return DownloadLocalizedTexts;
 }
+
+void UGridlyTask_DownloadLocalizedTexts::ReleasePool()
+{
+	// The pooled tasks are rooted, see Finish()
+	if (UObjectInitialized())
+	{
+		for (UGridlyTask_DownloadLocalizedTexts* Task : DownloadTaskPool)
+		{
+			Task->RemoveFromRoot();
+		}
+	}
+
+	DownloadTaskPool.Empty();
+}
@@ -2,32 +2,58 @@
 
 #include "GridlyTask_ImportDataTableFromGridly.h"
 
-#include "Engine/EngineTypes.h"
-#include "Engine/World.h"
-#include "TimerManager.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
 #include "GridlyDataTableImporterJSON.h"
 #include "Gridly.h"
 #include "GridlyGameSettings.h"
+#include "GridlyRequestPacer.h"
 #include "GridlyTableRow.h"
+#include "GridlyViewCache.h"
 #include "HttpModule.h"
 #include "JsonObjectConverter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tasks/Task.h"
 #include "GenericPlatform/GenericPlatformHttp.h"
 #include "Runtime/Online/HTTP/Public/Interfaces/IHttpResponse.h"
 
-UGridlyTask_ImportDataTableFromGridly::UGridlyTask_ImportDataTableFromGridly()
+/** Cached pages hold the decoded table rows. Bump when FGridlyTableRow's serialization changes */
+static const FString GridlyTableRowsConversionKey = TEXT("GridlyTableRows_1");
+
+static bool LoadCachedTableRows(const FString& ViewId, const int Offset, const int Limit, TArray<FGridlyTableRow>& OutTableRows)
 {
-	if (!HasAnyFlags(RF_ClassDefaultObject))
+	FGridlyCachedPage CachedPage;
+	if (FGridlyViewCache::LoadPage(ViewId, Offset, Limit, GridlyTableRowsConversionKey, CachedPage))
 	{
-		AddToRoot();
+		FMemoryReader Reader(CachedPage.Payload);
+		Reader << OutTableRows;
+		return !Reader.IsError();
 	}
+
+	return false;
+}
+
+UGridlyTask_ImportDataTableFromGridly::UGridlyTask_ImportDataTableFromGridly()
+{
 }
 
 void UGridlyTask_ImportDataTableFromGridly::Activate()
 {
-	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+	// Kept alive until the import has finished, see Finish()
+	AddToRoot();
+	bIsRunning = true;
+
+	Settings = FGridlySettingsSnapshot::Capture();
 
-	Limit = GameSettings->ImportMaxRecordsPerRequest;
+	Limit = Settings->ImportMaxRecordsPerRequest;
 	TotalCount = 0;
+	ReceivedCount = 0;
+	bUseCache = Settings->bCacheImportedPages;
+	MaxRetries = FMath::Max(0, Settings->ImportMaxRetriesPerPage);
+	RetryBaseDelay = Settings->ImportRetryBaseDelay;
+	CurrentRetryAttempts = 0;
+	CurrentThrottledAttempts = 0;
 
 	ViewIds.Reset();
 	if (GridlyDataTable && !GridlyDataTable->ViewId.IsEmpty())
@@ -49,9 +75,7 @@ void UGridlyTask_ImportDataTableFromGridly::RequestPage(const int ViewIdIndex, c
 	{
 		const FGridlyResult FailResult = FGridlyResult{"Unable to import data table: no view IDs were specified"};
 		UE_LOG(LogGridly, Error, TEXT("%s"), *FailResult.Message);
-		OnFail.Broadcast(GridlyTableRows, 1.f, FailResult);
-		if (OnFailDelegate.IsBound())
-			OnFailDelegate.Execute(GridlyTableRows, FailResult);
+		Fail(FailResult);
 		return;
 	}
 
@@ -59,8 +83,7 @@ void UGridlyTask_ImportDataTableFromGridly::RequestPage(const int ViewIdIndex, c
 	{
 		const FString& ViewId = ViewIds[ViewIdIndex];
 
-		const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
-		const FString ApiKey = GameSettings->ImportApiKey;
+		const FString ApiKey = Settings->ImportApiKey;
 
 		const FString PaginationSettings = FGenericPlatformHttp::UrlEncode(FString::Printf(TEXT("{\"offset\":%d,\"limit\":%d}"),
 			Offset,
@@ -80,29 +103,36 @@ void UGridlyTask_ImportDataTableFromGridly::RequestPage(const int ViewIdIndex, c
 		HttpRequest->SetVerb(TEXT("GET"));
 		HttpRequest->SetURL(Url);
 
-		HttpRequest->OnProcessRequestComplete().BindUObject(this, &UGridlyTask_ImportDataTableFromGridly::OnProcessRequestComplete);
+		bHasCachedPage = bUseCache && FGridlyViewCache::LoadValidators(ViewId, Offset, Limit, GridlyTableRowsConversionKey,
+			CachedPage);
+		// The first page also tells the size of the view. A 304 for it doesn't mean no rows were added further on, so it is
+		// always downloaded, and only skips the decoding when its content hash matches
+		if (bHasCachedPage && Offset > 0)
+		{
+			FGridlyViewCache::AddConditionalHeaders(HttpRequest, CachedPage);
+		}
 
-		OnProgress.Broadcast(GridlyTableRows, .1f, FGridlyResult::Success);
-		if (OnProgressDelegate.IsBound())
-			OnProgressDelegate.Execute(GridlyTableRows, .1f);
+		HttpRequest->OnProcessRequestComplete().BindUObject(this, &UGridlyTask_ImportDataTableFromGridly::OnProcessRequestComplete);
 
-		// Throttles number of requests by sleeping between each
+		// Sends right away unless Gridly has asked us to slow down
 
-		UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
-		if (World)
+		const double SendDelay = FGridlyRequestPacer::Get().ReserveSendDelay();
+		if (SendDelay > 0.0)
 		{
-			FTimerHandle TimerHandle;
-			World->GetTimerManager().SetTimer(TimerHandle, [this, ViewId, Offset]()
+			TickerHandles.Add(FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, ViewId, Offset](float)
 			{
-				HttpRequest->ProcessRequest();
-				UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
-			}, 1.f, false);
+				if (bIsRunning && HttpRequest.IsValid())
+				{
+					HttpRequest->ProcessRequest();
+					UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
+				}
+				return false;
+			}), SendDelay));
 		}
 		else
 		{
 			HttpRequest->ProcessRequest();
 			UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
-			FPlatformProcess::Sleep(1.f);
 		}
 	}
 	else
@@ -136,6 +166,8 @@ void UGridlyTask_ImportDataTableFromGridly::RequestPage(const int ViewIdIndex, c
 			OnSuccess.Broadcast(GridlyTableRows, 1.f, FGridlyResult::Success);
 			if (OnSuccessDelegate.IsBound())
 				OnSuccessDelegate.Execute(GridlyTableRows);
+
+			Finish();
 		}
 		else
 		{
@@ -145,9 +177,7 @@ void UGridlyTask_ImportDataTableFromGridly::RequestPage(const int ViewIdIndex, c
 			}
 
 			const FGridlyResult FailResult = FGridlyResult{"Failed to parse downloaded content"};
-			OnFail.Broadcast(GridlyTableRows, 1.f, FailResult);
-			if (OnFailDelegate.IsBound())
-				OnFailDelegate.Execute(GridlyTableRows, FailResult);
+			Fail(FailResult);
 		}
 	}
 }
@@ -155,7 +185,26 @@ void UGridlyTask_ImportDataTableFromGridly::RequestPage(const int ViewIdIndex, c
 void UGridlyTask_ImportDataTableFromGridly::OnProcessRequestComplete(FHttpRequestPtr HttpRequestPtr,
 	FHttpResponsePtr HttpResponsePtr, bool bSuccess)
 {
-	if (bSuccess && HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok)
+	if (FGridlyRequestPacer::Get().OnResponse(HttpResponsePtr))
+	{
+		if (++CurrentThrottledAttempts > FGridlyRequestPacer::MaxThrottledAttempts)
+		{
+			const FGridlyResult FailResult = FGridlyResult{FString::Printf(
+				TEXT("Failed to import offset %d of view ID: %s, the server kept throttling the requests"), CurrentOffset,
+				*ViewIds[CurrentViewIdIndex])};
+			UE_LOG(LogGridly, Error, TEXT("%s"), *FailResult.Message);
+			Fail(FailResult);
+			return;
+		}
+
+		// Throttled, try this page again once the pacer allows it
+		RequestPage(CurrentViewIdIndex, CurrentOffset);
+		return;
+	}
+
+	const bool bNotModified = bSuccess && bHasCachedPage && HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::NotModified;
+
+	if (bSuccess && (HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok || bNotModified))
 	{
 		// Header
 
@@ -165,54 +214,205 @@ void UGridlyTask_ImportDataTableFromGridly::OnProcessRequestComplete(FHttpReques
 			UE_LOG(LogGridly, Verbose, TEXT("%s"), *Headers[i]);
 		}
 
-		// Convert from JSON to texts
+		const FString TotalCountHeader = HttpResponsePtr->GetHeader(TEXT("X-Total-Count"));
+		const int ViewIdTotalCount = bNotModified && TotalCountHeader.IsEmpty()
+			                             ? CachedPage.TotalCount
+			                             : FCString::Atoi(*TotalCountHeader);
 
-		const FString Content = HttpResponsePtr->GetContentAsString();
-		UE_LOG(LogGridly, Verbose, TEXT("%s"), *Content);
+		// Decode the JSON on a worker thread, only the merge happens on the game thread
 
-		TArray<FGridlyTableRow> TableRows;
+		const FString ViewId = ViewIds[CurrentViewIdIndex];
+		const FString CachedContentHash = bHasCachedPage ? CachedPage.ContentHash : FString();
 
-		if (FJsonObjectConverter::JsonArrayStringToUStruct(Content, &TableRows, 0, 0))
+		TWeakObjectPtr<UGridlyTask_ImportDataTableFromGridly> WeakThis(this);
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, HttpResponsePtr, ViewId, Offset = CurrentOffset, PageLimit = Limit,
+			bCachePage = bUseCache, bNotModified, CachedContentHash, ViewIdTotalCount]()
 		{
-			GridlyTableRows.Append(TableRows);
+			TArray<FGridlyTableRow> TableRows;
+			bool bConverted = false;
+			bool bFromCache = false;
 
-			const int ViewIdTotalCount = FCString::Atoi(*HttpResponsePtr->GetHeader("X-Total-Count"));
-			TotalCount += CurrentOffset == 0 ? ViewIdTotalCount : 0;
-			const float EstimatedProgressViewIds =
-				static_cast<float>(CurrentViewIdIndex) / static_cast<float>(FMath::Max(1, ViewIds.Num()));
-			const float EstimatedProgressPagination = static_cast<float>(GridlyTableRows.Num()) / static_cast<float>(TotalCount);
-			const float EstimatedProgress = (EstimatedProgressViewIds + EstimatedProgressPagination) / 2.f;
+			FGridlyCachedPage Page;
+			if (!bNotModified)
+			{
+				FGridlyViewCache::ReadValidators(HttpResponsePtr, Page);
+			}
 
-			OnProgress.Broadcast(GridlyTableRows, EstimatedProgress, FGridlyResult::Success);
-			if (OnProgressDelegate.IsBound())
-				OnProgressDelegate.Execute(GridlyTableRows, EstimatedProgress);
+			// Unchanged pages are taken from the cache without parsing
 
-			if ((CurrentOffset + Limit) < TotalCount)
+			if (bNotModified || (!CachedContentHash.IsEmpty() && Page.ContentHash == CachedContentHash))
 			{
-				RequestPage(CurrentViewIdIndex, CurrentOffset + Limit);
+				bConverted = bFromCache = LoadCachedTableRows(ViewId, Offset, PageLimit, TableRows);
 			}
-			else
+
+			if (!bFromCache && !bNotModified)
+			{
+				const FString Content = HttpResponsePtr->GetContentAsString();
+				UE_LOG(LogGridly, Verbose, TEXT("%s"), *Content);
+
+				TableRows.Reset();
+				bConverted = FJsonObjectConverter::JsonArrayStringToUStruct(Content, &TableRows, 0, 0);
+
+				if (bConverted && bCachePage)
+				{
+					FMemoryWriter Writer(Page.Payload);
+					Writer << TableRows;
+					FGridlyViewCache::SavePage(ViewId, Offset, PageLimit, GridlyTableRowsConversionKey, Page);
+				}
+			}
+
+			// The server said the page is unchanged, but the cached copy is gone or unreadable
+			const bool bCacheMiss = bNotModified && !bFromCache;
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, bConverted, bCacheMiss, ViewIdTotalCount,
+				TableRows = MoveTemp(TableRows)]() mutable
+			{
+				if (UGridlyTask_ImportDataTableFromGridly* Task = WeakThis.Get())
+				{
+					Task->OnPageConverted(bConverted, bCacheMiss, ViewIdTotalCount, MoveTemp(TableRows));
+				}
+			});
+		});
+	}
+	else if (FGridlyRequestPacer::IsRetryable(bSuccess, HttpResponsePtr) && CurrentRetryAttempts < MaxRetries)
+	{
+		CurrentRetryAttempts++;
+
+		const double RetryDelay = FGridlyRequestPacer::GetRetryDelay(CurrentRetryAttempts, RetryBaseDelay);
+		UE_LOG(LogGridly, Warning, TEXT("Failed to download offset %d of view ID: %s, retrying in %.1f s (%d/%d)"), CurrentOffset,
+			*ViewIds[CurrentViewIdIndex], RetryDelay, CurrentRetryAttempts, MaxRetries);
+
+		TickerHandles.Add(FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+		{
+			if (bIsRunning)
 			{
-				RequestPage(CurrentViewIdIndex + 1, 0);
+				RequestPage(CurrentViewIdIndex, CurrentOffset);
 			}
+			return false;
+		}), RetryDelay));
+	}
+	else
+	{
+		const FGridlyResult FailResult = FGridlyResult{"Failed to connect to Gridly"};
+		Fail(FailResult);
+	}
+}
+
+void UGridlyTask_ImportDataTableFromGridly::Cancel()
+{
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	UE_LOG(LogGridly, Log, TEXT("Cancelled importing data table from Gridly"));
+
+	if (HttpRequest.IsValid())
+	{
+		HttpRequest->OnProcessRequestComplete().Unbind();
+		HttpRequest->CancelRequest();
+	}
+
+	Fail(FGridlyResult::Cancelled);
+}
+
+void UGridlyTask_ImportDataTableFromGridly::Fail(const FGridlyResult& FailResult)
+{
+	OnFail.Broadcast(GridlyTableRows, 1.f, FailResult);
+	if (OnFailDelegate.IsBound())
+		OnFailDelegate.Execute(GridlyTableRows, FailResult);
+
+	Finish();
+}
+
+void UGridlyTask_ImportDataTableFromGridly::Finish()
+{
+	bIsRunning = false;
+	HttpRequest.Reset();
+	Settings.Reset();
+
+	for (const FTSTicker::FDelegateHandle& TickerHandle : TickerHandles)
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+	TickerHandles.Reset();
+
+	// The listeners have been given the rows already
+	GridlyTableRows.Empty();
+	CachedPage = FGridlyCachedPage();
+
+	RemoveFromRoot();
+	SetReadyToDestroy();
+}
+
+void UGridlyTask_ImportDataTableFromGridly::OnPageConverted(const bool bConverted, const bool bCacheMiss, const int ViewIdTotalCount,
+	TArray<FGridlyTableRow>&& TableRows)
+{
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	if (bCacheMiss)
+	{
+		// Download the page again, this time without validators
+		FGridlyViewCache::RemovePage(ViewIds[CurrentViewIdIndex], CurrentOffset, Limit);
+		RequestPage(CurrentViewIdIndex, CurrentOffset);
+		return;
+	}
+
+	if (bConverted)
+	{
+		TotalCount += CurrentOffset == 0 ? ViewIdTotalCount : 0;
+		ReceivedCount += TableRows.Num();
+		CurrentRetryAttempts = 0;
+		CurrentThrottledAttempts = 0;
+
+		const float EstimatedProgressViewIds =
+			static_cast<float>(CurrentViewIdIndex) / static_cast<float>(FMath::Max(1, ViewIds.Num()));
+		const float EstimatedProgressPagination = static_cast<float>(ReceivedCount) / static_cast<float>(FMath::Max(1, TotalCount));
+		const float EstimatedProgress = (EstimatedProgressViewIds + EstimatedProgressPagination) / 2.f;
+
+		// Only the rows of this page are passed on, the accumulated rows are kept for the data table and OnSuccess
+
+		OnProgress.Broadcast(TableRows, EstimatedProgress, FGridlyResult::Success);
+		if (OnProgressDelegate.IsBound())
+			OnProgressDelegate.Execute(TableRows, EstimatedProgress);
+
+		// A listener may have cancelled the import
+		if (!bIsRunning)
+		{
+			return;
+		}
+
+		GridlyTableRows.Append(MoveTemp(TableRows));
+
+		if ((CurrentOffset + Limit) < TotalCount)
+		{
+			RequestPage(CurrentViewIdIndex, CurrentOffset + Limit);
 		}
 		else
 		{
-			const FGridlyResult FailResult = FGridlyResult{"Failed to parse downloaded content"};
-			OnFail.Broadcast(GridlyTableRows, 1.f, FailResult);
-			if (OnFailDelegate.IsBound())
-				OnFailDelegate.Execute(GridlyTableRows, FailResult);
+			RequestPage(CurrentViewIdIndex + 1, 0);
 		}
 	}
 	else
 	{
-		const FGridlyResult FailResult = FGridlyResult{"Failed to connect to Gridly"};
-		OnFail.Broadcast(GridlyTableRows, 1.f, FailResult);
-		if (OnFailDelegate.IsBound())
-			OnFailDelegate.Execute(GridlyTableRows, FailResult);
+		const FGridlyResult FailResult = FGridlyResult{"Failed to parse downloaded content"};
+		Fail(FailResult);
 	}
 }
 
+int UGridlyTask_ImportDataTableFromGridly::GetReceivedCount() const
+{
+	return ReceivedCount;
+}
+
+int UGridlyTask_ImportDataTableFromGridly::GetTotalCount() const
+{
+	return TotalCount;
+}
+
 UGridlyTask_ImportDataTableFromGridly* UGridlyTask_ImportDataTableFromGridly::ImportDataTableFromGridly(
 	const UObject* WorldContextObject, UGridlyDataTable* GridlyDataTable)
 {
@@ -4,16 +4,19 @@
 
 // Include necessary Unreal Engine headers
 #include "Gridly.h"
-#include "GridlyGameSettings.h"
+#include "GridlySettingsSnapshot.h"
 
 #if WITH_EDITOR
 #include "LocalizationSettings.h"
 #include "LocalizationTargetTypes.h"
 #endif
 
-// For culture and regex handling
-#include "Internationalization/Regex.h"
+// For culture handling
+#include "Internationalization/Internationalization.h"
+#include "Internationalization/TextLocalizationManager.h"
+#include "Misc/CoreDelegates.h"
 #include "Kismet/KismetInternationalizationLibrary.h"
+#include "Misc/ScopeLock.h"
 
 // For logging
 #include "Logging/LogMacros.h"
@@ -22,32 +25,35 @@
 #include "Containers/Array.h"
 #include "Containers/UnrealString.h"
 
-TArray<FString> FGridlyCultureConverter::GetTargetCultures()
+namespace GridlyCultureConverter
+{
+	FCriticalSection TargetCulturesLock;
+	TOptional<TArray<FString>> CachedTargetCultures;
+
+#if WITH_EDITOR
+	FDelegateHandle ObjectPropertyChangedHandle;
+#else
+	FDelegateHandle CultureChangedHandle;
+	FDelegateHandle PakFileMountedHandle;
+#endif
+}
+
+static TArray<FString> CollectTargetCultures()
 {
 	TArray<FString> TargetCultures;
 
 #if WITH_EDITOR
 	TArray<ULocalizationTarget*> LocalizationTargets = ULocalizationSettings::GetGameTargetSet()->TargetObjects;
 
-	FString CulturesString;
-
 	for (int i = 0; i < LocalizationTargets.Num(); i++)
 	{
-		TArray<FCultureStatistics> CultureStatistics = LocalizationTargets[i]->Settings.SupportedCulturesStatistics;
-		for (int j = 0; j < CultureStatistics.Num(); j++)
+		for (const FCultureStatistics& CultureStatistics : LocalizationTargets[i]->Settings.SupportedCulturesStatistics)
 		{
-			const FString& Culture = CultureStatistics[j].CultureName;
-			TargetCultures.Add(Culture);
-
-			if (CulturesString.Len() > 0)
-			{
-				CulturesString.Append(", ");
-			}
-			CulturesString.Append(Culture);
+			TargetCultures.Add(CultureStatistics.CultureName);
 		}
 	}
 
-	UE_LOG(LogGridly, Verbose, TEXT("Available cultures: %s"), *CulturesString);
+	UE_LOG(LogGridly, Verbose, TEXT("Available cultures: %s"), *FString::Join(TargetCultures, TEXT(", ")));
 #else
 	TargetCultures = FTextLocalizationManager::Get().GetLocalizedCultureNames(ELocalizationLoadFlags::Game);
 
@@ -60,69 +66,219 @@ TArray<FString> FGridlyCultureConverter::GetTargetCultures()
 	return TargetCultures;
 }
 
-bool FGridlyCultureConverter::ConvertFromGridly(
-	const TArray<FString>& AvailableCultures, const FString& GridlyCulture, FString& OutCulture)
+TArray<FString> FGridlyCultureConverter::GetTargetCultures()
 {
-	if (GridlyCulture.Len() > 0)
+	FScopeLock Lock(&GridlyCultureConverter::TargetCulturesLock);
+
+	if (!GridlyCultureConverter::CachedTargetCultures.IsSet())
 	{
-		// Use custom mapping if it is available
+		GridlyCultureConverter::CachedTargetCultures = CollectTargetCultures();
+	}
+
+	return GridlyCultureConverter::CachedTargetCultures.GetValue();
+}
 
-		UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+void FGridlyCultureConverter::InvalidateTargetCultures()
+{
+	FScopeLock Lock(&GridlyCultureConverter::TargetCulturesLock);
+	GridlyCultureConverter::CachedTargetCultures.Reset();
+}
 
-		if (GameSettings->bUseCustomCultureMapping)
+void FGridlyCultureConverter::Initialize()
+{
+#if WITH_EDITOR
+	GridlyCultureConverter::ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda(
+		[](UObject* Object, FPropertyChangedEvent&)
 		{
-			const FString* CustomCulture = GameSettings->CustomCultureMapping.FindKey(GridlyCulture);
+			if (Object && (Object->IsA<ULocalizationTarget>() || Object->IsA<ULocalizationTargetSet>()))
+			{
+				InvalidateTargetCultures();
+			}
+		});
+#else
+	// Not OnTextRevisionChangedEvent, which also fires for every batch of texts registered by the plugin itself.
+	// Mounting a pak can add localization resources, and a culture change reloads them
+	GridlyCultureConverter::CultureChangedHandle = FInternationalization::Get().OnCultureChanged().AddStatic(
+		&FGridlyCultureConverter::InvalidateTargetCultures);
+	GridlyCultureConverter::PakFileMountedHandle = FCoreDelegates::GetOnPakFileMounted2().AddLambda([](const IPakFile&)
+	{
+		InvalidateTargetCultures();
+	});
+#endif
+}
+
+void FGridlyCultureConverter::Shutdown()
+{
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(GridlyCultureConverter::ObjectPropertyChangedHandle);
+#else
+	if (FInternationalization::IsAvailable())
+	{
+		FInternationalization::Get().OnCultureChanged().Remove(GridlyCultureConverter::CultureChangedHandle);
+	}
+	FCoreDelegates::GetOnPakFileMounted2().Remove(GridlyCultureConverter::PakFileMountedHandle);
+#endif
+
+	InvalidateTargetCultures();
+}
 
-			if (CustomCulture != nullptr)
+FGridlyCultureConverter::FGridlyCultureConverter(const FGridlySettingsSnapshot& Settings,
+	const TArray<FString>& InAvailableCultures)
+	: AvailableCultures(InAvailableCultures)
+{
+	AvailableCultureSet.Append(AvailableCultures);
+
+	if (Settings.bUseCustomCultureMapping)
+	{
+		ToGridlyMapping = Settings.CustomCultureMapping;
+
+		// The first culture mapped to a Gridly culture wins, like TMap::FindKey would
+		for (const TPair<FString, FString>& Pair : Settings.CustomCultureMapping)
+		{
+			if (!FromGridlyMapping.Contains(Pair.Value))
 			{
-				OutCulture = *CustomCulture;
-				return true;
+				FromGridlyMapping.Add(Pair.Value, Pair.Key);
 			}
 		}
+	}
+}
 
-		// Otherwise follow rules of "enUS" -> "en-US"
-		
-		FString Culture = GridlyCulture;
-		const FRegexPattern RegexPattern("([a-z]+)([A-Z]+)");
-		FRegexMatcher RegexMatcher(RegexPattern, GridlyCulture);
-		if (RegexMatcher.FindNext())
+bool FGridlyCultureConverter::FromGridly(const FString& GridlyCulture, FString& OutCulture) const
+{
+	if (const TOptional<FString>* Result = FromGridlyResults.Find(GridlyCulture))
+	{
+		if (Result->IsSet())
 		{
-			Culture = RegexMatcher.GetCaptureGroup(1) + "-" + RegexMatcher.GetCaptureGroup(2);
-			OutCulture = UKismetInternationalizationLibrary::GetSuitableCulture(AvailableCultures, Culture, TEXT(""));
+			OutCulture = Result->GetValue();
 			return true;
 		}
+		return false;
+	}
+
+	TOptional<FString>& Result = FromGridlyResults.Add(GridlyCulture);
+
+	if (GridlyCulture.Len() > 0)
+	{
+		// Use custom mapping if it is available
+
+		if (const FString* CustomCulture = FromGridlyMapping.Find(GridlyCulture))
+		{
+			Result = *CustomCulture;
+		}
+		else
+		{
+			FString Culture;
+			if (SplitGridlyCulture(GridlyCulture, Culture))
+			{
+				// An exact match is what GetSuitableCulture would pick first
+				Result = AvailableCultureSet.Contains(Culture)
+					? Culture
+					: UKismetInternationalizationLibrary::GetSuitableCulture(AvailableCultures, Culture, TEXT(""));
+			}
+		}
+	}
+
+	if (Result.IsSet())
+	{
+		OutCulture = Result.GetValue();
+		return true;
 	}
 
 	return false;
 }
 
-bool FGridlyCultureConverter::ConvertToGridly(const FString& Culture, FString& OutGridlyCulture)
+bool FGridlyCultureConverter::ToGridly(const FString& Culture, FString& OutGridlyCulture) const
 {
+	if (const TOptional<FString>* Result = ToGridlyResults.Find(Culture))
+	{
+		if (Result->IsSet())
+		{
+			OutGridlyCulture = Result->GetValue();
+			return true;
+		}
+		return false;
+	}
+
+	TOptional<FString>& Result = ToGridlyResults.Add(Culture);
+
 	if (Culture.Len() > 0)
 	{
 		// Use custom mapping if it is available
 
-		UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+		FString GridlyCulture;
+		if (const FString* CustomCulture = ToGridlyMapping.Find(Culture))
+		{
+			Result = *CustomCulture;
+		}
+		else if (JoinCulture(Culture, GridlyCulture))
+		{
+			Result = MoveTemp(GridlyCulture);
+		}
+	}
+
+	if (Result.IsSet())
+	{
+		OutGridlyCulture = Result.GetValue();
+		return true;
+	}
 
-		if (GameSettings->bUseCustomCultureMapping)
+	return false;
+}
+
+bool FGridlyCultureConverter::SplitGridlyCulture(const FString& GridlyCulture, FString& OutCulture)
+{
+	// Follows the rules of "enUS" -> "en-US", i.e. the first match of ([a-z]+)([A-Z]+)
+
+	const int32 Len = GridlyCulture.Len();
+	int32 LowerStart = 0;
+
+	while (LowerStart < Len)
+	{
+		if (GridlyCulture[LowerStart] < TEXT('a') || GridlyCulture[LowerStart] > TEXT('z'))
 		{
-			const FString* CustomCulture = GameSettings->CustomCultureMapping.Find(Culture);
+			LowerStart++;
+			continue;
+		}
 
-			if (CustomCulture != nullptr)
-			{
-				OutGridlyCulture = *CustomCulture;
-				return true;
-			}
+		int32 UpperStart = LowerStart;
+		while (UpperStart < Len && GridlyCulture[UpperStart] >= TEXT('a') && GridlyCulture[UpperStart] <= TEXT('z'))
+		{
+			UpperStart++;
 		}
 
-		// Otherwise follow rules of "en-US" -> "enUS"
+		int32 UpperEnd = UpperStart;
+		while (UpperEnd < Len && GridlyCulture[UpperEnd] >= TEXT('A') && GridlyCulture[UpperEnd] <= TEXT('Z'))
+		{
+			UpperEnd++;
+		}
 
-		FString Left, Right;
-		if (Culture.Split("-", &Left, &Right))
+		if (UpperEnd > UpperStart)
 		{
-			OutGridlyCulture = Left + Right;
+			OutCulture.Reset(UpperEnd - LowerStart + 1);
+			OutCulture.AppendChars(*GridlyCulture + LowerStart, UpperStart - LowerStart);
+			OutCulture.AppendChar(TEXT('-'));
+			OutCulture.AppendChars(*GridlyCulture + UpperStart, UpperEnd - UpperStart);
 			return true;
 		}
+
+		// No match can start inside this run of lowercase letters
+		LowerStart = UpperStart;
+	}
+
+	return false;
+}
+
+bool FGridlyCultureConverter::JoinCulture(const FString& Culture, FString& OutGridlyCulture)
+{
+	// Follows the rules of "en-US" -> "enUS", only the first separator is removed
+
+	int32 SeparatorIndex;
+	if (Culture.FindChar(TEXT('-'), SeparatorIndex))
+	{
+		OutGridlyCulture.Reset(Culture.Len() - 1);
+		OutGridlyCulture.AppendChars(*Culture, SeparatorIndex);
+		OutGridlyCulture.AppendChars(*Culture + SeparatorIndex + 1, Culture.Len() - SeparatorIndex - 1);
+		return true;
 	}
 
 	return false;
@@ -4,11 +4,40 @@
 
 #include "CoreMinimal.h"
 
+struct FGridlySettingsSnapshot;
+
 class GRIDLY_API FGridlyCultureConverter
 {
 public:
+	/**
+	 * Captures the culture mapping settings, so keep one converter around for a whole import or export.
+	 * Results are memoized, which makes a converter unsafe to share between threads
+	 */
+	FGridlyCultureConverter(const FGridlySettingsSnapshot& Settings, const TArray<FString>& InAvailableCultures);
+
+	bool FromGridly(const FString& GridlyCulture, FString& OutCulture) const;
+	bool ToGridly(const FString& Culture, FString& OutGridlyCulture) const;
+
+public:
+	/** Target cultures are cached until the localization targets change, see InvalidateTargetCultures */
 	static TArray<FString> GetTargetCultures();
-	static bool ConvertFromGridly(const TArray<FString>& AvailableCultures, const FString& GridlyCulture,
-		FString& OutCulture);
-	static bool ConvertToGridly(const FString& Culture, FString& OutGridlyCulture);
+
+	/** Makes the next GetTargetCultures call collect the cultures again. Called when the localization targets change */
+	static void InvalidateTargetCultures();
+
+	static void Initialize();
+	static void Shutdown();
+
+private:
+	static bool SplitGridlyCulture(const FString& GridlyCulture, FString& OutCulture);
+	static bool JoinCulture(const FString& Culture, FString& OutGridlyCulture);
+
+	TArray<FString> AvailableCultures;
+	TSet<FString> AvailableCultureSet;
+	TMap<FString, FString> ToGridlyMapping;
+	TMap<FString, FString> FromGridlyMapping;
+
+	// Conversions already made, unset when there is no matching culture
+	mutable TMap<FString, TOptional<FString>> ToGridlyResults;
+	mutable TMap<FString, TOptional<FString>> FromGridlyResults;
 };
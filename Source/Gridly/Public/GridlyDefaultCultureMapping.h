@@ -0,0 +1,171 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** An Unreal culture and the Gridly culture it is mapped to unless the project overrides it */
+struct FGridlyDefaultCultureMapping
+{
+	const TCHAR* Culture;
+	const TCHAR* GridlyCulture;
+};
+
+namespace GridlyDefaultCultureMapping
+{
+	/** Seeds UGridlyGameSettings::CustomCultureMapping and the generated GridlyConfig.ini */
+	inline constexpr FGridlyDefaultCultureMapping Entries[] =
+	{
+		{TEXT("en-US"), TEXT("enUS")},
+		{TEXT("ar-SA"), TEXT("arSA")},
+		{TEXT("ca-ES"), TEXT("caES")},
+		{TEXT("zh-CN"), TEXT("zhCN")},
+		{TEXT("zh-TW"), TEXT("zhTW")},
+		{TEXT("de-DE"), TEXT("deDE")},
+		{TEXT("it-IT"), TEXT("itIT")},
+		{TEXT("ja-JP"), TEXT("jaJP")},
+		{TEXT("ko-KR"), TEXT("koKR")},
+		{TEXT("pl-PL"), TEXT("plPL")},
+		{TEXT("pt-BR"), TEXT("ptBR")},
+		{TEXT("ru-RU"), TEXT("ruRU")},
+		{TEXT("es-MX"), TEXT("esMX")},
+		{TEXT("es-ES"), TEXT("esES")},
+		{TEXT("bn-BD"), TEXT("bnBD")},
+		{TEXT("bg-BG"), TEXT("bgBG")},
+		{TEXT("zh-HK"), TEXT("zhHK")},
+		{TEXT("cs-CZ"), TEXT("csCZ")},
+		{TEXT("da-DK"), TEXT("daDK")},
+		{TEXT("nl-NL"), TEXT("nlNL")},
+		{TEXT("fi-FI"), TEXT("fiFI")},
+		{TEXT("fr-CA"), TEXT("frCA")},
+		{TEXT("fr-FR"), TEXT("frFR")},
+		{TEXT("el-GR"), TEXT("elGR")},
+		{TEXT("he-IL"), TEXT("heIL")},
+		{TEXT("hi-IN"), TEXT("hiIN")},
+		{TEXT("hu-HU"), TEXT("huHU")},
+		{TEXT("id-ID"), TEXT("idID")},
+		{TEXT("jw-ID"), TEXT("jwID")},
+		{TEXT("lv-LV"), TEXT("lvLV")},
+		{TEXT("ms-MY"), TEXT("msMY")},
+		{TEXT("no-NO"), TEXT("noNO")},
+		{TEXT("pt-PT"), TEXT("ptPT")},
+		{TEXT("ro-RO"), TEXT("roRO")},
+		{TEXT("sk-SK"), TEXT("skSK")},
+		{TEXT("sv-SE"), TEXT("svSE")},
+		{TEXT("tl-PH"), TEXT("tlPH")},
+		{TEXT("th-TH"), TEXT("thTH")},
+		{TEXT("tr-TR"), TEXT("trTR")},
+		{TEXT("uk-UA"), TEXT("ukUA")},
+		{TEXT("ur-IN"), TEXT("urIN")},
+		{TEXT("vi-VN"), TEXT("viVN")},
+		{TEXT("af-ZA"), TEXT("afZA")},
+		{TEXT("ar-AE"), TEXT("arAE")},
+		{TEXT("ar-BH"), TEXT("arBH")},
+		{TEXT("ar-DZ"), TEXT("arDZ")},
+		{TEXT("ar-EG"), TEXT("arEG")},
+		{TEXT("ar-IQ"), TEXT("arIQ")},
+		{TEXT("ar-JO"), TEXT("arJO")},
+		{TEXT("ar-KW"), TEXT("arKW")},
+		{TEXT("ar-LB"), TEXT("arLB")},
+		{TEXT("ar-LY"), TEXT("arLY")},
+		{TEXT("ar-MA"), TEXT("arMA")},
+		{TEXT("ar-OM"), TEXT("arOM")},
+		{TEXT("ar-QA"), TEXT("arQA")},
+		{TEXT("ar-SY"), TEXT("arSY")},
+		{TEXT("ar-TN"), TEXT("arTN")},
+		{TEXT("ar-YE"), TEXT("arYE")},
+		{TEXT("az-AZ"), TEXT("azAZ")},
+		{TEXT("be-BY"), TEXT("beBY")},
+		{TEXT("bs-BA"), TEXT("bsBA")},
+		{TEXT("cy-GB"), TEXT("cyGB")},
+		{TEXT("de-AT"), TEXT("deAT")},
+		{TEXT("de-CH"), TEXT("deCH")},
+		{TEXT("de-LI"), TEXT("deLI")},
+		{TEXT("de-LU"), TEXT("deLU")},
+		{TEXT("dv-MV"), TEXT("dvMV")},
+		{TEXT("en-AU"), TEXT("enAU")},
+		{TEXT("en-BZ"), TEXT("enBZ")},
+		{TEXT("en-CA"), TEXT("enCA")},
+		{TEXT("en-GB"), TEXT("enGB")},
+		{TEXT("en-IE"), TEXT("enIE")},
+		{TEXT("en-JM"), TEXT("enJM")},
+		{TEXT("en-NZ"), TEXT("enNZ")},
+		{TEXT("en-PH"), TEXT("enPH")},
+		{TEXT("en-TT"), TEXT("enTT")},
+		{TEXT("en-ZA"), TEXT("enZA")},
+		{TEXT("en-ZW"), TEXT("enZW")},
+		{TEXT("es-AR"), TEXT("esAR")},
+		{TEXT("es-BO"), TEXT("esBO")},
+		{TEXT("es-CL"), TEXT("esCL")},
+		{TEXT("es-CO"), TEXT("esCO")},
+		{TEXT("es-CR"), TEXT("esCR")},
+		{TEXT("es-DO"), TEXT("esDO")},
+		{TEXT("es-EC"), TEXT("esEC")},
+		{TEXT("es-GT"), TEXT("esGT")},
+		{TEXT("es-HN"), TEXT("esHN")},
+		{TEXT("es-NI"), TEXT("esNI")},
+		{TEXT("es-PA"), TEXT("esPA")},
+		{TEXT("es-PE"), TEXT("esPE")},
+		{TEXT("es-PR"), TEXT("esPR")},
+		{TEXT("es-PY"), TEXT("esPY")},
+		{TEXT("es-SV"), TEXT("esSV")},
+		{TEXT("es-UY"), TEXT("esUY")},
+		{TEXT("es-VE"), TEXT("esVE")},
+		{TEXT("et-EE"), TEXT("etEE")},
+		{TEXT("eu-ES"), TEXT("euES")},
+		{TEXT("fa-IR"), TEXT("faIR")},
+		{TEXT("fo-FO"), TEXT("foFO")},
+		{TEXT("fr-BE"), TEXT("frBE")},
+		{TEXT("fr-CH"), TEXT("frCH")},
+		{TEXT("fr-LU"), TEXT("frLU")},
+		{TEXT("fr-MC"), TEXT("frMC")},
+		{TEXT("gl-ES"), TEXT("glES")},
+		{TEXT("gu-IN"), TEXT("guIN")},
+		{TEXT("hr-BA"), TEXT("hrBA")},
+		{TEXT("hr-HR"), TEXT("hrHR")},
+		{TEXT("hy-AM"), TEXT("hyAM")},
+		{TEXT("is-IS"), TEXT("isIS")},
+		{TEXT("it-CH"), TEXT("itCH")},
+		{TEXT("ka-GE"), TEXT("kaGE")},
+		{TEXT("kk-KZ"), TEXT("kkKZ")},
+		{TEXT("kn-IN"), TEXT("knIN")},
+		{TEXT("kok-IN"), TEXT("kokIN")},
+		{TEXT("ky-KG"), TEXT("kyKG")},
+		{TEXT("lt-LT"), TEXT("ltLT")},
+		{TEXT("mi-NZ"), TEXT("miNZ")},
+		{TEXT("mk-MK"), TEXT("mkMK")},
+		{TEXT("mn-MN"), TEXT("mnMN")},
+		{TEXT("mr-IN"), TEXT("mrIN")},
+		{TEXT("ms-BN"), TEXT("msBN")},
+		{TEXT("mt-MT"), TEXT("mtMT")},
+		{TEXT("nb-NO"), TEXT("nbNO")},
+		{TEXT("nl-BE"), TEXT("nlBE")},
+		{TEXT("nn-NO"), TEXT("nnNO")},
+		{TEXT("ns-ZA"), TEXT("nsZA")},
+		{TEXT("pa-IN"), TEXT("paIN")},
+		{TEXT("ps-AR"), TEXT("psAR")},
+		{TEXT("qu-BO"), TEXT("quBO")},
+		{TEXT("qu-EC"), TEXT("quEC")},
+		{TEXT("qu-PE"), TEXT("quPE")},
+		{TEXT("sa-IN"), TEXT("saIN")},
+		{TEXT("se-FI"), TEXT("seFI")},
+		{TEXT("se-NO"), TEXT("seNO")},
+		{TEXT("se-SE"), TEXT("seSE")},
+		{TEXT("sl-SI"), TEXT("slSI")},
+		{TEXT("sq-AL"), TEXT("sqAL")},
+		{TEXT("sr-BA"), TEXT("srBA")},
+		{TEXT("sv-FI"), TEXT("svFI")},
+		{TEXT("sw-KE"), TEXT("swKE")},
+		{TEXT("syr-SY"), TEXT("syrSY")},
+		{TEXT("ta-IN"), TEXT("taIN")},
+		{TEXT("te-IN"), TEXT("teIN")},
+		{TEXT("tn-ZA"), TEXT("tnZA")},
+		{TEXT("tt-RU"), TEXT("ttRU")},
+		{TEXT("ur-PK"), TEXT("urPK")},
+		{TEXT("uz-UZ"), TEXT("uzUZ")},
+		{TEXT("xh-ZA"), TEXT("xhZA")},
+		{TEXT("zh-MO"), TEXT("zhMO")},
+		{TEXT("zh-SG"), TEXT("zhSG")},
+		{TEXT("zu-ZA"), TEXT("zuZA")},
+	};
+}
@@ -27,7 +27,7 @@ public:
 };
 
 UCLASS(BlueprintType, Config = Game, DefaultConfig,
-    AutoExpandCategories = ("Gridly|Import Settings", "Gridly|Export Settings", "Gridly|Options"))
+    AutoExpandCategories = ("Gridly|Import Settings", "Gridly|Export Settings", "Gridly|Live Update", "Gridly|Options"))
     class GRIDLY_API UGridlyGameSettings final : public UObject
 {
     GENERATED_BODY()
@@ -45,6 +45,50 @@ public:
     UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config, meta = (ClampMin = "1", ClampMax = "1000"))
     int ImportMaxRecordsPerRequest = 1000;
 
+    /** The max amount of page requests kept in flight at once when importing a view. Pages are merged back in order */
+    UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config, meta = (ClampMin = "1", ClampMax = "16"))
+    int ImportMaxConcurrentRequests = 4;
+
+    /** Keeps downloaded pages in Saved/Gridly/Cache and revalidates them on the next import, so unchanged pages are neither downloaded nor parsed again */
+    UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config)
+    bool bCacheImportedPages = true;
+
+    /** Runtime only. Saves the texts of every successful download, and passes them to UpdateLocalizationPreview when the first download of the next launch starts, so the game has texts while it downloads or when it is offline */
+    UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config)
+    bool bUseOfflineTextCache = true;
+
+    /** The amount of finished text download tasks kept for reuse, which avoids allocating a new task on every Live Preview refresh. 0 disables pooling */
+    UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config, meta = (ClampMin = "0", ClampMax = "8"))
+    int ImportTaskPoolSize = 2;
+
+    /** How many times a page is requested again after a connection or server error, before the import fails */
+    UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config, meta = (ClampMin = "0", ClampMax = "10"))
+    int ImportMaxRetriesPerPage = 3;
+
+    /** Delay in seconds before the first retry of a failed page. Doubled on every following retry */
+    UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config, meta = (ClampMin = "0.1", ClampMax = "60"))
+    float ImportRetryBaseDelay = 1.f;
+
+    /** Only requests the source/target language and namespace columns of the imported cultures, instead of every column in the view */
+    UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config)
+    bool bImportOnlyUsedColumns = true;
+
+    /** Editor only. Writes the imported translations straight to the .archive files of the localization target, instead of writing .po files and running the import commandlet on them */
+    UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config)
+    bool bImportDirectlyToArchives = false;
+
+    /** Downloads the import views periodically while the game runs and applies the texts that changed, so translations can be checked in a running build. Meant for QA and test builds */
+    UPROPERTY(Category = "Gridly|Live Update", BlueprintReadOnly, EditAnywhere, Config)
+    bool bEnableLiveUpdate = false;
+
+    /** Seconds between two downloads of the import views */
+    UPROPERTY(Category = "Gridly|Live Update", BlueprintReadOnly, EditAnywhere, Config, meta = (ClampMin = "5", ClampMax = "3600", EditCondition = "bEnableLiveUpdate"))
+    float LiveUpdateInterval = 30.f;
+
+    /** Milliseconds spent applying changed texts each frame. Large changes are spread over several frames instead of causing a spike */
+    UPROPERTY(Category = "Gridly|Live Update", BlueprintReadOnly, EditAnywhere, Config, meta = (ClampMin = "0.1", ClampMax = "33", EditCondition = "bEnableLiveUpdate"))
+    float LiveUpdateFrameBudgetMs = 2.f;
+
     /** The API key can be retrieved from your Gridly dashboard. Make sure you have write access */
     UPROPERTY(Category = "Gridly|Export Settings", BlueprintReadOnly, EditAnywhere, Transient)
     FString ExportApiKey;
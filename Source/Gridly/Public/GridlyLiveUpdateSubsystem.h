@@ -0,0 +1,66 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "Internationalization/PolyglotTextData.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+
+#include "GridlyLiveUpdateSubsystem.generated.h"
+
+class UGridlyTask_DownloadLocalizedTexts;
+struct FGridlyResult;
+
+/**
+ * Keeps the texts of a running game up to date with Gridly while UGridlyGameSettings::bEnableLiveUpdate is set.
+ * The import views are downloaded every LiveUpdateInterval seconds. Each page is compared with the texts registered so far
+ * (see FGridlyTextRegistry) on a worker thread, and the texts that changed are registered with the localization manager once per frame, as many
+ * as fit in LiveUpdateFrameBudgetMs
+ */
+UCLASS()
+class GRIDLY_API UGridlyLiveUpdateSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Downloads the views now instead of waiting for the next poll. Does nothing while an update is in progress */
+	UFUNCTION(Category = Gridly, BlueprintCallable)
+	void RefreshNow();
+
+	/** The amount of changed texts waiting to be applied */
+	UFUNCTION(Category = Gridly, BlueprintPure)
+	int GetPendingCount() const;
+
+private:
+	bool Poll(float DeltaTime);
+	bool ApplyPendingTexts(float DeltaTime);
+	bool IsUpdating() const;
+
+	void OnPageDownloaded(const TArray<FPolyglotTextData>& PageTexts, float Progress);
+	void OnDownloadSucceeded(const TArray<FPolyglotTextData>& PolyglotTextDatas);
+	void OnDownloadFailed(const TArray<FPolyglotTextData>& PolyglotTextDatas, const FGridlyResult& Result);
+
+private:
+	UPROPERTY()
+	TObjectPtr<UGridlyTask_DownloadLocalizedTexts> DownloadTask;
+
+	TArray<FTSTicker::FDelegateHandle> TickerHandles;
+	float FrameBudgetSeconds = 0.002f;
+
+	uint32 RunSerial = 0;
+	int PagesInFlight = 0;
+
+	// Changed texts, applied from PendingIndex onwards
+	TArray<FPolyglotTextData> PendingTexts;
+	// The registry hashes of PendingTexts, recorded once a text has been registered
+	TArray<TPair<uint64, uint64>> PendingHashes;
+	int PendingIndex = 0;
+	int AppliedCount = 0;
+
+	// Texts registered in one frame, adjusted to the frame budget, see ApplyPendingTexts
+	int TextsPerFrame = 0;
+};
@@ -6,168 +6,489 @@
 #include "GridlyCultureConverter.h"
 #include "GridlyDataTableImporterJSON.h"
 #include "GridlyGameSettings.h"
+#include "GridlyPoWriter.h"
+#include "GridlySettingsSnapshot.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Hash/xxhash.h"
 #include "Internationalization/PolyglotTextData.h"
-#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
 
-bool FGridlyLocalizedTextConverter::TableRowsToPolyglotTextDatas(const TArray<FGridlyTableRow>& TableRows,
-	TMap<FString, FPolyglotTextData>& OutPolyglotTextDatas)
+namespace GridlyLocalizedTextConverter
 {
-	UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
-	const TArray<FString> TargetCultures = FGridlyCultureConverter::GetTargetCultures();
+	/** Fewer rows than this are converted on the calling thread. A full page of 1000 records is split in 7 shards */
+	constexpr int MinRowsPerShard = 128;
 
-	const bool bUseCombinedNamespaceKey = GameSettings->bUseCombinedNamespaceId;
-	const bool bUsePathAsNamespace = !bUseCombinedNamespaceKey && GameSettings->NamespaceColumnId == "path";
+	/** The amount of texts encoded at once when writing .po files. Bounds the shared msgctxt/msgid lines kept in memory */
+	constexpr int32 PoEntriesPerBlock = 1024;
+}
 
-	for (int i = 0; i < TableRows.Num(); i++)
+/** What a column holds, resolved once per column ID instead of once per cell */
+struct FGridlyColumnRoute
+{
+	enum class ERole : uint8
 	{
-		UE_LOG(LogGridly, Verbose, TEXT("Row %d: %s (%s)"), i, *TableRows[i].Id, *TableRows[i].Path);
+		Ignored,
+		Namespace,
+		Source,
+		Target
+	};
+
+	ERole Role = ERole::Ignored;
+	FString Culture;
 
-		FString Key = TableRows[i].Id;
-		FString FullKey = Key;
-		FString Namespace = bUsePathAsNamespace ? TableRows[i].Path : TEXT("");
-		FString SourceCulture;
-		FString SourceText;
-		TMap<FString, FString> Translations;
+	/** Index of Culture in the cultures interned by the shard, so rows compare and collect cultures as integers */
+	int CultureIndex = INDEX_NONE;
+};
 
-		for (int j = 0; j < TableRows[i].Cells.Num(); j++)
+static FGridlyColumnRoute ResolveColumnRoute(const FGridlySettingsSnapshot& Settings, const FGridlyCultureConverter& CultureConverter,
+	const bool bUsePathAsNamespace, const FString& ColumnId)
+{
+	FGridlyColumnRoute Route;
+
+	if (!bUsePathAsNamespace && ColumnId == Settings.NamespaceColumnId)
+	{
+		Route.Role = FGridlyColumnRoute::ERole::Namespace;
+	}
+	else if (ColumnId.StartsWith(Settings.SourceLanguageColumnIdPrefix))
+	{
+		const FString GridlyCulture = ColumnId.RightChop(Settings.SourceLanguageColumnIdPrefix.Len());
+		if (CultureConverter.FromGridly(GridlyCulture, Route.Culture))
 		{
-			const FGridlyTableCell& GridlyTableCell = TableRows[i].Cells[j];
+			Route.Role = FGridlyColumnRoute::ERole::Source;
+		}
+	}
+	else if (ColumnId.StartsWith(Settings.TargetLanguageColumnIdPrefix))
+	{
+		const FString GridlyCulture = ColumnId.RightChop(Settings.TargetLanguageColumnIdPrefix.Len());
+		if (CultureConverter.FromGridly(GridlyCulture, Route.Culture))
+		{
+			Route.Role = FGridlyColumnRoute::ERole::Target;
+		}
+	}
 
-			// If special columns
+	return Route;
+}
 
-			if (!bUsePathAsNamespace && GridlyTableCell.ColumnId == GameSettings->NamespaceColumnId)
-			{
-				Namespace = GridlyTableCell.Value;
-				continue;
-			}
+/** FString map keys hash and compare case-insensitively, but namespaces are case-sensitive like FLocKey */
+struct FGridlyCaseSensitiveKeyFuncs : TDefaultMapKeyFuncs<FString, FString, false>
+{
+	static bool Matches(const FString& A, const FString& B)
+	{
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+
+	static uint32 GetKeyHash(const FString& Key)
+	{
+		return FCrc::StrCrc32(*Key);
+	}
+};
+
+/** Converts the rows in [StartIndex, EndIndex) in order. Uses its own converter and routes, so shards can run in parallel */
+static void TableRowsToPolyglotTextDataShard(const TArray<FGridlyTableRow>& TableRows, const int StartIndex, const int EndIndex,
+	const FGridlySettingsSnapshot& Settings, const TArray<FString>& TargetCultures,
+	TArray<TPair<FString, FPolyglotTextData>>& OutShard)
+{
+	const bool bUseCombinedNamespaceKey = Settings.bUseCombinedNamespaceId;
+	const bool bUsePathAsNamespace = !bUseCombinedNamespaceKey && Settings.NamespaceColumnId == "path";
+
+	// A view only has a handful of columns, so they are routed once and every cell is a lookup
+	TMap<FString, FGridlyColumnRoute> ColumnRoutes;
+	const FGridlyCultureConverter CultureConverter(Settings, TargetCultures);
+
+	// Cultures and namespaces repeat on every row. Both are interned for the shard, so a row only refers to them while it is
+	// converted. This saves the temporary copies and lookups of the conversion only: FPolyglotTextData owns its strings, so
+	// each text still gets its own copy of its namespace and cultures, and the converted texts take as much memory as before
+	TArray<FString> Cultures;
+	TMap<FString, FString, FDefaultSetAllocator, FGridlyCaseSensitiveKeyFuncs> CleanNamespaces;
+	const FString EmptyString;
 
-			// If language column
+	// The translation of each interned culture on the current row, empty cells included
+	TArray<const FString*, TInlineAllocator<32>> Translations;
 
-			if (GridlyTableCell.ColumnId.StartsWith(GameSettings->SourceLanguageColumnIdPrefix))
+	OutShard.Reserve(FMath::Max(0, EndIndex - StartIndex));
+
+	for (int i = StartIndex; i < EndIndex; i++)
+	{
+		const FGridlyTableRow& TableRow = TableRows[i];
+		UE_LOG(LogGridly, Verbose, TEXT("Row %d: %s (%s)"), i, *TableRow.Id, *TableRow.Path);
+
+		const FString* Namespace = bUsePathAsNamespace ? &TableRow.Path : &EmptyString;
+		const FString* SourceCulture = &EmptyString;
+		const FString* SourceText = &EmptyString;
+		Translations.Reset();
+		Translations.SetNumZeroed(Cultures.Num());
+
+		for (const FGridlyTableCell& GridlyTableCell : TableRow.Cells)
+		{
+			const FGridlyColumnRoute* Route = ColumnRoutes.Find(GridlyTableCell.ColumnId);
+			if (!Route)
 			{
-				const FString GridlyCulture = GridlyTableCell.ColumnId.RightChop(GameSettings->SourceLanguageColumnIdPrefix.Len());
-				FString Culture;
-				if (FGridlyCultureConverter::ConvertFromGridly(TargetCultures, GridlyCulture, Culture))
+				FGridlyColumnRoute NewRoute = ResolveColumnRoute(Settings, CultureConverter, bUsePathAsNamespace, GridlyTableCell.ColumnId);
+				if (NewRoute.Role == FGridlyColumnRoute::ERole::Target)
 				{
-					SourceCulture = Culture;
-					SourceText = GridlyTableCell.Value;
+					NewRoute.CultureIndex = Cultures.AddUnique(NewRoute.Culture);
+					Translations.SetNumZeroed(Cultures.Num());
 				}
+				Route = &ColumnRoutes.Add(GridlyTableCell.ColumnId, MoveTemp(NewRoute));
 			}
-			else if (GridlyTableCell.ColumnId.StartsWith(GameSettings->TargetLanguageColumnIdPrefix))
+
+			switch (Route->Role)
 			{
-				const FString GridlyCulture = GridlyTableCell.ColumnId.RightChop(GameSettings->TargetLanguageColumnIdPrefix.Len());
-				FString Culture;
-				if (FGridlyCultureConverter::ConvertFromGridly(TargetCultures, GridlyCulture, Culture))
-				{
-					Translations.Add(Culture, GridlyTableCell.Value);
-				}
+			case FGridlyColumnRoute::ERole::Namespace:
+				Namespace = &GridlyTableCell.Value;
+				break;
+			case FGridlyColumnRoute::ERole::Source:
+				SourceCulture = &Route->Culture;
+				SourceText = &GridlyTableCell.Value;
+				break;
+			case FGridlyColumnRoute::ERole::Target:
+				Translations[Route->CultureIndex] = &GridlyTableCell.Value;
+				break;
+			default:
+				break;
 			}
 		}
 
 		// Namespace / key fixes
 
+		FString Key = TableRow.Id;
+		FString CombinedNamespace;
 		if (bUseCombinedNamespaceKey)
 		{
 			FString NewKey;
-			if (Key.Split(",", &Namespace, &NewKey))
+			if (Key.Split(",", &CombinedNamespace, &NewKey))
 			{
 				Key = NewKey;
+				Namespace = &CombinedNamespace;
 			}
 		}
 
-		Namespace = Namespace.Replace(TEXT(" "), TEXT(""));
+		const FString* CleanNamespace = CleanNamespaces.Find(*Namespace);
+		if (!CleanNamespace)
+		{
+			CleanNamespace = &CleanNamespaces.Add(*Namespace, Namespace->Replace(TEXT(" "), TEXT("")));
+		}
 
-		if (SourceText.IsEmpty() || SourceCulture.IsEmpty())
+		if (SourceText->IsEmpty() || SourceCulture->IsEmpty())
 		{
 			UE_LOG(LogGridly, Warning, TEXT("Could not find native culture/source string in imported text with key: %s,%s"),
-				*Namespace, *Key);
+				**CleanNamespace, *Key);
 			//continue;
 		}
 
-		FPolyglotTextData PolyglotTextData(ELocalizedTextSourceCategory::Game, Namespace, Key, SourceText, SourceCulture);
+		FPolyglotTextData PolyglotTextData(ELocalizedTextSourceCategory::Game, *CleanNamespace, Key, *SourceText, *SourceCulture);
 
-		for (const TPair<FString, FString>& Pair : Translations)
+		for (int CultureIndex = 0; CultureIndex < Translations.Num(); CultureIndex++)
 		{
-			if (!Pair.Value.IsEmpty())
+			if (Translations[CultureIndex] && !Translations[CultureIndex]->IsEmpty())
 			{
-				PolyglotTextData.AddLocalizedString(Pair.Key, Pair.Value);
+				PolyglotTextData.AddLocalizedString(Cultures[CultureIndex], *Translations[CultureIndex]);
 			}
 		}
 
-		OutPolyglotTextDatas.Add(FullKey, PolyglotTextData);
+		OutShard.Emplace(TableRow.Id, MoveTemp(PolyglotTextData));
+	}
+}
+
+bool FGridlyLocalizedTextConverter::TableRowsToPolyglotTextDatas(const TArray<FGridlyTableRow>& TableRows,
+	const FGridlySettingsSnapshot& Settings, const TArray<FString>& TargetCultures,
+	TMap<FString, FPolyglotTextData>& OutPolyglotTextDatas)
+{
+	// Rows are independent, so large pages are split in contiguous shards converted in parallel. The shards are merged in row
+	// order, which gives the same result as converting the rows one by one
+
+	const int NumRows = TableRows.Num();
+	const int NumShards = FMath::Clamp(NumRows / GridlyLocalizedTextConverter::MinRowsPerShard, 1,
+		FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	const int RowsPerShard = FMath::DivideAndRoundUp(FMath::Max(NumRows, 1), NumShards);
+
+	TArray<TArray<TPair<FString, FPolyglotTextData>>> Shards;
+	Shards.SetNum(NumShards);
+
+	ParallelFor(NumShards, [&TableRows, &Settings, &TargetCultures, &Shards, NumRows, RowsPerShard](const int32 ShardIndex)
+	{
+		const int StartIndex = ShardIndex * RowsPerShard;
+		const int EndIndex = FMath::Min(StartIndex + RowsPerShard, NumRows);
+		TableRowsToPolyglotTextDataShard(TableRows, StartIndex, EndIndex, Settings, TargetCultures, Shards[ShardIndex]);
+	});
+
+	OutPolyglotTextDatas.Reserve(OutPolyglotTextDatas.Num() + NumRows);
+
+	for (TArray<TPair<FString, FPolyglotTextData>>& Shard : Shards)
+	{
+		for (TPair<FString, FPolyglotTextData>& Pair : Shard)
+		{
+			OutPolyglotTextDatas.Add(MoveTemp(Pair.Key), MoveTemp(Pair.Value));
+		}
 	}
 
 	return OutPolyglotTextDatas.Num() > 0;
 }
 
-// Taken from "Engine\Source\Developer\Localization\Private\PortableObjectPipeline.cpp"
-FString ConditionArchiveStrForPO(const FString& InStr)
+
+bool FGridlyLocalizedTextConverter::GetImportColumnIds(const FGridlySettingsSnapshot& Settings, const TArray<FString>& TargetCultures,
+	TArray<FString>& OutColumnIds)
 {
-	FString Result = InStr;
-	Result.ReplaceInline(TEXT("\\"), TEXT("\\\\"), ESearchCase::CaseSensitive);
-	Result.ReplaceInline(TEXT("\""), TEXT("\\\""), ESearchCase::CaseSensitive);
-	Result.ReplaceInline(TEXT("\r"), TEXT("\\r"), ESearchCase::CaseSensitive);
-	Result.ReplaceInline(TEXT("\n"), TEXT("\\n"), ESearchCase::CaseSensitive);
-	Result.ReplaceInline(TEXT("\t"), TEXT("\\t"), ESearchCase::CaseSensitive);
-	return Result;
+	const FGridlyCultureConverter CultureConverter(Settings, TargetCultures);
+
+	OutColumnIds.Reset();
+
+	for (int i = 0; i < TargetCultures.Num(); i++)
+	{
+		FString GridlyCulture;
+		if (!CultureConverter.ToGridly(TargetCultures[i], GridlyCulture))
+		{
+			// Without a Gridly culture we can't tell which columns hold this culture, so nothing can be left out
+			UE_LOG(LogGridly, Log, TEXT("No Gridly culture for %s, requesting all columns"), *TargetCultures[i]);
+			OutColumnIds.Reset();
+			return false;
+		}
+
+		OutColumnIds.AddUnique(Settings.SourceLanguageColumnIdPrefix + GridlyCulture);
+		OutColumnIds.AddUnique(Settings.TargetLanguageColumnIdPrefix + GridlyCulture);
+	}
+
+	// "path" is part of every record, any other namespace column has to be asked for
+
+	if (Settings.NamespaceColumnId != "path" && !Settings.NamespaceColumnId.IsEmpty())
+	{
+		OutColumnIds.AddUnique(Settings.NamespaceColumnId);
+	}
+
+	return OutColumnIds.Num() > 0;
 }
 
-bool FGridlyLocalizedTextConverter::WritePoFile(const TArray<FPolyglotTextData>& PolyglotTextDatas, const FString& TargetCulture,
-	const FString& Path)
+FString FGridlyLocalizedTextConverter::GetConversionKey(const FGridlySettingsSnapshot& Settings, const TArray<FString>& TargetCultures)
 {
-	TArray<FString> Lines;
-	int numOfLines = 0;
-	TArray<TCHAR> CharsToReplace = { TEXT('\n'), TEXT('\r'), TEXT('\t'), TEXT('"'), TEXT('\\') };
+	// Bump the version when the converted data or its serialization changes
+	FString Key = TEXT("PolyglotTextDatas_1");
 
-	for (int i = 0; i < PolyglotTextDatas.Num(); i++)
-	{
-		FString TargetString;
+	Key += FString::Printf(TEXT("|%d|%d|%s|%s|%s"), Settings.bUseCombinedNamespaceId ? 1 : 0,
+		Settings.bImportOnlyUsedColumns ? 1 : 0, *Settings.NamespaceColumnId, *Settings.SourceLanguageColumnIdPrefix,
+		*Settings.TargetLanguageColumnIdPrefix);
+	Key += TEXT("|") + FString::Join(TargetCultures, TEXT(","));
 
-		if (PolyglotTextDatas[i].GetLocalizedString(TargetCulture, TargetString))
+	if (Settings.bUseCustomCultureMapping)
+	{
+		for (const TPair<FString, FString>& Pair : Settings.CustomCultureMapping)
 		{
-			Lines.Add(FString::Printf(TEXT("msgctxt \"%s,%s\""), *PolyglotTextDatas[i].GetNamespace(),
-				*PolyglotTextDatas[i].GetKey()));
+			Key += FString::Printf(TEXT("|%s=%s"), *Pair.Key, *Pair.Value);
+		}
+	}
+
+	return FMD5::HashAnsiString(*Key);
+}
 
-			
-			FString NativeString = PolyglotTextDatas[i].GetNativeString().ReplaceCharWithEscapedChar(&CharsToReplace);
-			Lines.Add(FString::Printf(TEXT("msgid \"%s\""), *NativeString));
+void FGridlyLocalizedTextConverter::SerializePolyglotTextDatas(FArchive& Ar, TArray<FPolyglotTextData>& PolyglotTextDatas)
+{
+	int32 Num = PolyglotTextDatas.Num();
+	Ar << Num;
 
-			TargetString = ConditionArchiveStrForPO(TargetString);
-			//TargetString.ReplaceCharWithEscapedChar(&CharsToReplace);
-			Lines.Add(FString::Printf(TEXT("msgstr \"%s\""), *TargetString));
+	if (Ar.IsLoading())
+	{
+		if (Num < 0)
+		{
+			Ar.SetError();
+			return;
+		}
 
-			Lines.Add(TEXT(""));
-		}		
-		else {
-			Lines.Add(FString::Printf(TEXT("msgctxt \"%s,%s\""), *PolyglotTextDatas[i].GetNamespace(),
-				*PolyglotTextDatas[i].GetKey()));
+		PolyglotTextDatas.Reset(Num);
+	}
 
+	for (int32 i = 0; i < Num && !Ar.IsError(); i++)
+	{
+		uint8 Category = static_cast<uint8>(ELocalizedTextSourceCategory::Game);
+		FString Namespace;
+		FString Key;
+		FString NativeString;
+		FString NativeCulture;
+		TArray<FString> Cultures;
+		TArray<FString> LocalizedStrings;
 
-			FString NativeString = PolyglotTextDatas[i].GetNativeString().ReplaceCharWithEscapedChar(&CharsToReplace);
-			Lines.Add(FString::Printf(TEXT("msgid \"%s\""), *NativeString));
+		if (Ar.IsSaving())
+		{
+			const FPolyglotTextData& PolyglotTextData = PolyglotTextDatas[i];
+			Category = static_cast<uint8>(PolyglotTextData.GetCategory());
+			Namespace = PolyglotTextData.GetNamespace();
+			Key = PolyglotTextData.GetKey();
+			NativeString = PolyglotTextData.GetNativeString();
+			NativeCulture = PolyglotTextData.GetNativeCulture();
+			Cultures = PolyglotTextData.GetLocalizedCultures();
+			LocalizedStrings.SetNum(Cultures.Num());
+			for (int j = 0; j < Cultures.Num(); j++)
+			{
+				PolyglotTextData.GetLocalizedString(Cultures[j], LocalizedStrings[j]);
+			}
+		}
 
-			TargetString = TEXT("");
-			TargetString = TargetString.ReplaceCharWithEscapedChar(&CharsToReplace);
-			Lines.Add(FString::Printf(TEXT("msgstr \"%s\""), *TargetString));
+		Ar << Category << Namespace << Key << NativeString << NativeCulture << Cultures << LocalizedStrings;
 
-			Lines.Add(TEXT(""));
+		if (Ar.IsLoading() && !Ar.IsError())
+		{
+			FPolyglotTextData PolyglotTextData(static_cast<ELocalizedTextSourceCategory>(Category), Namespace, Key, NativeString,
+				NativeCulture);
+			for (int j = 0; j < Cultures.Num() && j < LocalizedStrings.Num(); j++)
+			{
+				PolyglotTextData.AddLocalizedString(Cultures[j], LocalizedStrings[j]);
+			}
+			PolyglotTextDatas.Add(MoveTemp(PolyglotTextData));
 		}
-		
 	}
+}
+
+static void HashString(FXxHash64Builder& Builder, const FString& String)
+{
+	// The length keeps neighbouring strings from running into each other
+	const int32 Len = String.Len();
+	Builder.Update(&Len, sizeof(Len));
+	Builder.Update(*String, Len * sizeof(TCHAR));
+}
+
+uint64 FGridlyLocalizedTextConverter::HashPolyglotTextData(const FPolyglotTextData& PolyglotTextData)
+{
+	FXxHash64Builder Builder;
+
+	const uint8 Category = static_cast<uint8>(PolyglotTextData.GetCategory());
+	Builder.Update(&Category, sizeof(Category));
+	HashString(Builder, PolyglotTextData.GetNativeCulture());
+	HashString(Builder, PolyglotTextData.GetNativeString());
+
+	TArray<FString> Cultures = PolyglotTextData.GetLocalizedCultures();
+	Cultures.Sort();
+
+	FString LocalizedString;
+	for (const FString& Culture : Cultures)
+	{
+		LocalizedString.Reset();
+		PolyglotTextData.GetLocalizedString(Culture, LocalizedString);
+		HashString(Builder, Culture);
+		HashString(Builder, LocalizedString);
+	}
+
+	return Builder.Finalize().Hash;
+}
+
+uint64 FGridlyLocalizedTextConverter::HashTextId(FStringView Namespace, FStringView Key)
+{
+	FXxHash64Builder Builder;
+	const int32 NamespaceLen = Namespace.Len();
+	Builder.Update(&NamespaceLen, sizeof(NamespaceLen));
+	Builder.Update(Namespace.GetData(), NamespaceLen * sizeof(TCHAR));
+	Builder.Update(Key.GetData(), Key.Len() * sizeof(TCHAR));
+	return Builder.Finalize().Hash;
+}
+
+bool FGridlyLocalizedTextConverter::WritePoFile(const TArray<FPolyglotTextData>& PolyglotTextDatas, const FString& TargetCulture,
+	const FString& Path)
+{
+	return WritePoFiles(PolyglotTextDatas, {TPair<FString, FString>(TargetCulture, Path)});
+}
+
+bool FGridlyLocalizedTextConverter::WritePoFiles(const TArray<FPolyglotTextData>& PolyglotTextDatas,
+	const TArray<TPair<FString, FString>>& CulturePaths, TArray<bool>* OutWritten)
+{
+	const int32 NumFiles = CulturePaths.Num();
+
+	TArray<TUniquePtr<FArchive>> Writers;
+	TArray<TUniquePtr<FGridlyPoWriter>> PoWriters;
+	Writers.SetNum(NumFiles);
+	PoWriters.SetNum(NumFiles);
 
-	if (FFileHelper::SaveStringArrayToFile(Lines, *Path))
+	for (int32 FileIndex = 0; FileIndex < NumFiles; FileIndex++)
 	{
-		UE_LOG(LogGridly, Log, TEXT("Exported .po file (%d lines): %s"), Lines.Num(), *Path);
-		if (Lines.Num() > 0) {
-			return true;
+		const FString& Path = CulturePaths[FileIndex].Value;
+		Writers[FileIndex].Reset(IFileManager::Get().CreateFileWriter(*Path));
+		if (Writers[FileIndex])
+		{
+			PoWriters[FileIndex] = MakeUnique<FGridlyPoWriter>(*Writers[FileIndex]);
 		}
-		else {
-			return false;
+		else
+		{
+			UE_LOG(LogGridly, Error, TEXT("Failed to export .po file to path: %s"), *Path);
 		}
 	}
-	else
+
+	// The texts are written in blocks. The msgctxt/msgid lines of a block are encoded once, then every file appends them
+	// with its own msgstr lines. Files only touch their own writer, so they are written in parallel
+
+	TArray<TArray<uint8>> Headers;
+	Headers.SetNum(FMath::Min(GridlyLocalizedTextConverter::PoEntriesPerBlock, PolyglotTextDatas.Num()));
+
+	for (int32 BlockStart = 0; BlockStart < PolyglotTextDatas.Num(); BlockStart += GridlyLocalizedTextConverter::PoEntriesPerBlock)
 	{
-		UE_LOG(LogGridly, Error, TEXT("Failed to export .po file to path: %s"), *Path);
-		return false;
-	}	
-}
\ No newline at end of file
+		const int32 BlockSize = FMath::Min(GridlyLocalizedTextConverter::PoEntriesPerBlock, PolyglotTextDatas.Num() - BlockStart);
+
+		ParallelFor(BlockSize, [&PolyglotTextDatas, &Headers, BlockStart](const int32 i)
+		{
+			const FPolyglotTextData& PolyglotTextData = PolyglotTextDatas[BlockStart + i];
+			Headers[i].Reset();
+			FGridlyPoWriter::EncodeEntryHeader(PolyglotTextData.GetNamespace(), PolyglotTextData.GetKey(),
+				PolyglotTextData.GetNativeString(), Headers[i]);
+		}, EParallelForFlags::Unbalanced);
+
+		ParallelFor(NumFiles, [&PolyglotTextDatas, &CulturePaths, &PoWriters, &Headers, BlockStart, BlockSize](const int32 FileIndex)
+		{
+			FGridlyPoWriter* PoWriter = PoWriters[FileIndex].Get();
+			if (!PoWriter)
+			{
+				return;
+			}
+
+			const FString& TargetCulture = CulturePaths[FileIndex].Key;
+			FString TargetString;
+
+			for (int32 i = 0; i < BlockSize; i++)
+			{
+				// Texts without a translation are written with an empty msgstr
+				TargetString.Reset();
+				PolyglotTextDatas[BlockStart + i].GetLocalizedString(TargetCulture, TargetString);
+
+				PoWriter->WriteEntryHeader(Headers[i]);
+				PoWriter->WriteEntryTranslation(TargetString);
+			}
+		});
+	}
+
+	bool bAllWritten = true;
+	if (OutWritten)
+	{
+		OutWritten->Init(false, NumFiles);
+	}
+
+	for (int32 FileIndex = 0; FileIndex < NumFiles; FileIndex++)
+	{
+		if (!PoWriters[FileIndex])
+		{
+			bAllWritten = false;
+			continue;
+		}
+
+		PoWriters[FileIndex]->Flush();
+		const int32 NumLines = PoWriters[FileIndex]->GetNumLines();
+		PoWriters[FileIndex].Reset();
+
+		const bool bClosed = Writers[FileIndex]->Close() && !Writers[FileIndex]->IsError();
+		Writers[FileIndex].Reset();
+
+		const FString& Path = CulturePaths[FileIndex].Value;
+		if (!bClosed)
+		{
+			UE_LOG(LogGridly, Error, TEXT("Failed to export .po file to path: %s"), *Path);
+			bAllWritten = false;
+			continue;
+		}
+
+		UE_LOG(LogGridly, Log, TEXT("Exported .po file (%d lines): %s"), NumLines, *Path);
+
+		// An empty file is written, but not reported as a success
+		const bool bWritten = NumLines > 0;
+		bAllWritten &= bWritten;
+		if (OutWritten)
+		{
+			(*OutWritten)[FileIndex] = bWritten;
+		}
+	}
+
+	return bAllWritten;
+}
@@ -6,10 +6,39 @@
 
 #include "GridlyTableRow.h"
 
+struct FGridlySettingsSnapshot;
+
 class GRIDLY_API FGridlyLocalizedTextConverter
 {
 public:
-	static bool TableRowsToPolyglotTextDatas(const TArray<FGridlyTableRow>& TableRows,
-		TMap<FString, FPolyglotTextData>& OutPolyglotTextDatas);
+	/**
+	 * Safe to call from worker threads, since it only reads the given settings snapshot. Take the snapshot with
+	 * FGridlySettingsSnapshot::Capture() and the cultures with FGridlyCultureConverter::GetTargetCultures() on the game thread
+	 */
+	static bool TableRowsToPolyglotTextDatas(const TArray<FGridlyTableRow>& TableRows, const FGridlySettingsSnapshot& Settings,
+		const TArray<FString>& TargetCultures, TMap<FString, FPolyglotTextData>& OutPolyglotTextDatas);
+
+	/** The columns TableRowsToPolyglotTextDatas reads for these cultures. Returns false if the columns can't be determined */
+	static bool GetImportColumnIds(const FGridlySettingsSnapshot& Settings, const TArray<FString>& TargetCultures,
+		TArray<FString>& OutColumnIds);
+
+	/** Identifies everything TableRowsToPolyglotTextDatas depends on, so cached conversions can be invalidated */
+	static FString GetConversionKey(const FGridlySettingsSnapshot& Settings, const TArray<FString>& TargetCultures);
+	static void SerializePolyglotTextDatas(FArchive& Ar, TArray<FPolyglotTextData>& PolyglotTextDatas);
+
+	/** Hashes the strings of a text, but not its namespace and key, so a text that has changed can be told from one that hasn't */
+	static uint64 HashPolyglotTextData(const FPolyglotTextData& PolyglotTextData);
+
+	/** Hashes the namespace and key of a text. Case-sensitive, like FLocKey */
+	static uint64 HashTextId(FStringView Namespace, FStringView Key);
+
 	static bool WritePoFile(const TArray<FPolyglotTextData>& PolyglotTextDatas, const FString& TargetCulture, const FString& Path);
+
+	/**
+	 * Writes a .po file for each culture/path pair. The texts are walked once: the parts shared by all cultures are escaped once
+	 * per text and the files are written in parallel. OutWritten receives the result of each file, as returned by WritePoFile.
+	 * Returns true if every file was written
+	 */
+	static bool WritePoFiles(const TArray<FPolyglotTextData>& PolyglotTextDatas, const TArray<TPair<FString, FString>>& CulturePaths,
+		TArray<bool>* OutWritten = nullptr);
 };
@@ -0,0 +1,146 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyPoWriter.h"
+
+namespace GridlyPoWriter
+{
+	void Append(TArray<uint8>& Out, const ANSICHAR* Chars)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(Chars), FCStringAnsi::Strlen(Chars));
+	}
+
+	void Append(TArray<uint8>& Out, const TCHAR* Chars, const int32 Len)
+	{
+		if (Len <= 0)
+		{
+			return;
+		}
+
+		const int32 Utf8Len = FPlatformString::ConvertedLength<UTF8CHAR>(Chars, Len);
+		const int32 Start = Out.Num();
+		Out.AddUninitialized(Utf8Len);
+		FPlatformString::Convert(reinterpret_cast<UTF8CHAR*>(Out.GetData() + Start), Utf8Len, Chars, Len);
+	}
+
+	/** Appends a string with the escaping of PortableObjectPipeline.cpp, in one pass over the string */
+	void AppendEscaped(TArray<uint8>& Out, const FString& String)
+	{
+		const TCHAR* Chars = *String;
+		const int32 Len = String.Len();
+		int32 RunStart = 0;
+
+		for (int32 i = 0; i < Len; i++)
+		{
+			const ANSICHAR* Escaped;
+			switch (Chars[i])
+			{
+			case TEXT('\\'):
+				Escaped = "\\\\";
+				break;
+			case TEXT('"'):
+				Escaped = "\\\"";
+				break;
+			case TEXT('\r'):
+				Escaped = "\\r";
+				break;
+			case TEXT('\n'):
+				Escaped = "\\n";
+				break;
+			case TEXT('\t'):
+				Escaped = "\\t";
+				break;
+			default:
+				continue;
+			}
+
+			// Runs of characters that don't need escaping are encoded in one go
+			Append(Out, Chars + RunStart, i - RunStart);
+			Append(Out, Escaped);
+			RunStart = i + 1;
+		}
+
+		Append(Out, Chars + RunStart, Len - RunStart);
+	}
+
+	void AppendLine(TArray<uint8>& Out, const ANSICHAR* Prefix, const FString& String)
+	{
+		Append(Out, Prefix);
+		AppendEscaped(Out, String);
+		Append(Out, "\"" LINE_TERMINATOR_ANSI);
+	}
+}
+
+FGridlyPoWriter::FGridlyPoWriter(FArchive& InAr, const int32 InBufferSize) :
+	Ar(InAr), BufferSize(FMath::Max(InBufferSize, 16))
+{
+	// Room for one more line, since the buffer is only flushed once a line has pushed it over its size
+	Buffer.Reserve(BufferSize + 1024);
+
+	static const uint8 Bom[] = {0xEF, 0xBB, 0xBF};
+	Buffer.Append(Bom, UE_ARRAY_COUNT(Bom));
+}
+
+FGridlyPoWriter::~FGridlyPoWriter()
+{
+	Flush();
+}
+
+void FGridlyPoWriter::WriteEntry(const FString& Namespace, const FString& Key, const FString& NativeString,
+	const FString& TargetString)
+{
+	EncodeEntryHeader(Namespace, Key, NativeString, Buffer);
+	NumLines += 2;
+
+	WriteEntryTranslation(TargetString);
+}
+
+void FGridlyPoWriter::EncodeEntryHeader(const FString& Namespace, const FString& Key, const FString& NativeString,
+	TArray<uint8>& OutHeader)
+{
+	// The context isn't escaped, same as before the writer streamed
+
+	GridlyPoWriter::Append(OutHeader, "msgctxt \"");
+	GridlyPoWriter::Append(OutHeader, *Namespace, Namespace.Len());
+	GridlyPoWriter::Append(OutHeader, ",");
+	GridlyPoWriter::Append(OutHeader, *Key, Key.Len());
+	GridlyPoWriter::Append(OutHeader, "\"" LINE_TERMINATOR_ANSI);
+
+	GridlyPoWriter::AppendLine(OutHeader, "msgid \"", NativeString);
+}
+
+void FGridlyPoWriter::WriteEntryHeader(const TArray<uint8>& Header)
+{
+	Buffer.Append(Header);
+	NumLines += 2;
+}
+
+void FGridlyPoWriter::WriteEntryTranslation(const FString& TargetString)
+{
+	GridlyPoWriter::AppendLine(Buffer, "msgstr \"", TargetString);
+	GridlyPoWriter::Append(Buffer, LINE_TERMINATOR_ANSI);
+	NumLines += 2;
+
+	FlushIfFull();
+}
+
+void FGridlyPoWriter::Flush()
+{
+	if (Buffer.Num() > 0)
+	{
+		Ar.Serialize(Buffer.GetData(), Buffer.Num());
+		Buffer.Reset();
+	}
+}
+
+int32 FGridlyPoWriter::GetNumLines() const
+{
+	return NumLines;
+}
+
+void FGridlyPoWriter::FlushIfFull()
+{
+	if (Buffer.Num() >= BufferSize)
+	{
+		Flush();
+	}
+}
@@ -0,0 +1,50 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace GridlyPoWriter
+{
+	constexpr int32 DefaultBufferSize = 64 * 1024;
+}
+
+/**
+ * Writes a .po file to an archive as UTF-8. Strings are escaped and encoded into one reusable buffer that is written out
+ * whenever it fills up, so memory use is bounded by the buffer size and the longest entry instead of the size of the file.
+ * The file starts with a UTF-8 BOM so it's read back as UTF-8 regardless of its content
+ */
+class GRIDLY_API FGridlyPoWriter
+{
+public:
+	explicit FGridlyPoWriter(FArchive& InAr, const int32 InBufferSize = GridlyPoWriter::DefaultBufferSize);
+	~FGridlyPoWriter();
+
+	/** Writes a msgctxt/msgid/msgstr entry and the empty line that ends it */
+	void WriteEntry(const FString& Namespace, const FString& Key, const FString& NativeString, const FString& TargetString);
+
+	/**
+	 * Encodes the msgctxt/msgid lines of an entry, which are the same in every culture. Writing them with WriteEntryHeader
+	 * lets several files share one encoding of each entry
+	 */
+	static void EncodeEntryHeader(const FString& Namespace, const FString& Key, const FString& NativeString, TArray<uint8>& OutHeader);
+
+	/** Writes the lines encoded by EncodeEntryHeader. Must be followed by WriteEntryTranslation */
+	void WriteEntryHeader(const TArray<uint8>& Header);
+
+	/** Writes the msgstr line and the empty line that end an entry */
+	void WriteEntryTranslation(const FString& TargetString);
+
+	/** Writes the buffered bytes to the archive */
+	void Flush();
+
+	int32 GetNumLines() const;
+
+private:
+	void FlushIfFull();
+
+	FArchive& Ar;
+	TArray<uint8> Buffer;
+	int32 BufferSize;
+	int32 NumLines = 0;
+};
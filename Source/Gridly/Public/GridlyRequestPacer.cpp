@@ -0,0 +1,160 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyRequestPacer.h"
+
+#include "Gridly.h"
+#include "Interfaces/IHttpResponse.h"
+
+namespace GridlyRequestPacer
+{
+	constexpr double InitialBackOffInterval = 0.5;
+	constexpr double MaxBackOffInterval = 30.0;
+
+	/** Below this interval the pacer considers the server healthy again and stops throttling */
+	constexpr double RecoveredInterval = 0.05;
+
+	/** When fewer requests than this remain in the rate limit window, the remaining ones are spread over the window */
+	constexpr int LowRemainingRequests = 10;
+}
+
+FGridlyRequestPacer& FGridlyRequestPacer::Get()
+{
+	static FGridlyRequestPacer RequestPacer;
+	return RequestPacer;
+}
+
+double FGridlyRequestPacer::ReserveSendDelay()
+{
+	const double Now = FPlatformTime::Seconds();
+	const double SendTime = FMath::Max3(Now, NextSendTime, BlockedUntil);
+	NextSendTime = SendTime + SendInterval;
+	return SendTime - Now;
+}
+
+bool FGridlyRequestPacer::OnResponse(const FHttpResponsePtr& HttpResponsePtr)
+{
+	if (!HttpResponsePtr.IsValid())
+	{
+		return false;
+	}
+
+	const int32 ResponseCode = HttpResponsePtr->GetResponseCode();
+	const double RetryAfter = ParseRetryAfter(HttpResponsePtr->GetHeader(TEXT("Retry-After")));
+
+	if (ResponseCode == EHttpResponseCodes::TooManyRequests || ResponseCode == EHttpResponseCodes::ServiceUnavail)
+	{
+		BackOff(RetryAfter);
+		UE_LOG(LogGridly, Warning, TEXT("Gridly is throttling requests (HTTP %d), backing off to %.2f requests/s"), ResponseCode,
+			GetCurrentSendRate());
+		return true;
+	}
+
+	// Rate limit headers on regular responses
+
+	const FString RemainingHeader = HttpResponsePtr->GetHeader(TEXT("X-RateLimit-Remaining"));
+	const FString ResetHeader = HttpResponsePtr->GetHeader(TEXT("X-RateLimit-Reset"));
+
+	if (!RemainingHeader.IsEmpty() && !ResetHeader.IsEmpty())
+	{
+		const int Remaining = FCString::Atoi(*RemainingHeader);
+		double ResetSeconds = FCString::Atod(*ResetHeader);
+
+		// Some servers send the reset as a unix timestamp rather than a number of seconds
+		if (ResetSeconds > 1000000000.0)
+		{
+			ResetSeconds -= static_cast<double>(FDateTime::UtcNow().ToUnixTimestamp());
+		}
+		ResetSeconds = FMath::Max(0.0, ResetSeconds);
+
+		if (Remaining <= 0)
+		{
+			BackOff(ResetSeconds);
+			return false;
+		}
+
+		if (Remaining < GridlyRequestPacer::LowRemainingRequests)
+		{
+			SendInterval = FMath::Min(ResetSeconds / Remaining, GridlyRequestPacer::MaxBackOffInterval);
+			return false;
+		}
+	}
+
+	if (RetryAfter > 0.0)
+	{
+		BlockedUntil = FMath::Max(BlockedUntil, FPlatformTime::Seconds() + RetryAfter);
+		return false;
+	}
+
+	Recover();
+	return false;
+}
+
+float FGridlyRequestPacer::GetCurrentSendRate() const
+{
+	return SendInterval > 0.0 ? static_cast<float>(1.0 / SendInterval) : 0.f;
+}
+
+bool FGridlyRequestPacer::IsRetryable(const bool bSuccess, const FHttpResponsePtr& HttpResponsePtr)
+{
+	if (!bSuccess || !HttpResponsePtr.IsValid())
+	{
+		return true;
+	}
+
+	const int32 ResponseCode = HttpResponsePtr->GetResponseCode();
+	return ResponseCode == EHttpResponseCodes::RequestTimeout || ResponseCode >= EHttpResponseCodes::ServerError;
+}
+
+double FGridlyRequestPacer::GetRetryDelay(const int Attempt, const double BaseDelay)
+{
+	// Jitter keeps parallel pages that failed together from retrying in lockstep
+	const double Delay = BaseDelay * FMath::Pow(2.0, FMath::Max(0, Attempt - 1));
+	return FMath::Min(Delay, GridlyRequestPacer::MaxBackOffInterval) * FMath::FRandRange(0.5, 1.5);
+}
+
+void FGridlyRequestPacer::BackOff(const double BlockSeconds)
+{
+	SendInterval = FMath::Clamp(SendInterval * 2.0, GridlyRequestPacer::InitialBackOffInterval,
+		GridlyRequestPacer::MaxBackOffInterval);
+
+	if (BlockSeconds > 0.0)
+	{
+		BlockedUntil = FMath::Max(BlockedUntil, FPlatformTime::Seconds() + BlockSeconds);
+	}
+}
+
+void FGridlyRequestPacer::Recover()
+{
+	if (SendInterval > 0.0)
+	{
+		SendInterval *= 0.5;
+		if (SendInterval < GridlyRequestPacer::RecoveredInterval)
+		{
+			SendInterval = 0.0;
+			UE_LOG(LogGridly, Log, TEXT("Gridly is no longer throttling requests"));
+		}
+	}
+}
+
+double FGridlyRequestPacer::ParseRetryAfter(const FString& RetryAfter)
+{
+	if (RetryAfter.IsEmpty())
+	{
+		return 0.0;
+	}
+
+	// Either a number of seconds or an HTTP date
+
+	if (RetryAfter.IsNumeric())
+	{
+		return FMath::Max(0.0, FCString::Atod(*RetryAfter));
+	}
+
+	FDateTime RetryTime;
+	if (FDateTime::ParseHttpDate(RetryAfter, RetryTime))
+	{
+		return FMath::Max(0.0, (RetryTime - FDateTime::UtcNow()).GetTotalSeconds());
+	}
+
+	return 0.0;
+}
@@ -0,0 +1,51 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpResponse.h"
+
+/**
+ * Paces requests sent to the Gridly API. Requests go out immediately while the server is healthy, and are only
+ * spaced out after the server signals rate limiting (HTTP 429/503, Retry-After or X-RateLimit-* headers).
+ * The pacer is shared by all import tasks since Gridly rate limits per API key.
+ */
+class GRIDLY_API FGridlyRequestPacer
+{
+public:
+	static FGridlyRequestPacer& Get();
+
+	/** Reserves a send slot and returns the delay in seconds before the request may be sent (0 = send now) */
+	double ReserveSendDelay();
+
+	/** Inspects a response for rate limit signals. Returns true if the request was throttled and should be retried */
+	bool OnResponse(const FHttpResponsePtr& HttpResponsePtr);
+
+	/** The current allowed send rate in requests per second, or 0 if requests are not being throttled */
+	float GetCurrentSendRate() const;
+
+	/** Whether a failed request is worth sending again: connection errors, timeouts and server errors */
+	static bool IsRetryable(const bool bSuccess, const FHttpResponsePtr& HttpResponsePtr);
+
+	/** Jittered exponential backoff in seconds before retry number Attempt (starting at 1) */
+	static double GetRetryDelay(const int Attempt, const double BaseDelay);
+
+	/** How many times a single page may be throttled before the import fails, so a long outage can't stall it forever */
+	static constexpr int MaxThrottledAttempts = 10;
+
+private:
+	void BackOff(const double BlockSeconds);
+	void Recover();
+
+	static double ParseRetryAfter(const FString& RetryAfter);
+
+private:
+	/** Minimum interval between two sends. 0 while the server is healthy */
+	double SendInterval = 0.0;
+
+	/** Earliest time the next reserved request may be sent */
+	double NextSendTime = 0.0;
+
+	/** Time until which the server asked us not to send anything */
+	double BlockedUntil = 0.0;
+};
@@ -5,3 +5,4 @@
 #include "GridlyResult.h"
 
 const FGridlyResult FGridlyResult::Success;
+const FGridlyResult FGridlyResult::Cancelled{TEXT("Cancelled"), true};
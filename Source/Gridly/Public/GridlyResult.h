@@ -14,5 +14,10 @@ struct GRIDLY_API FGridlyResult
 	UPROPERTY(Category = Gridly, VisibleAnywhere, BlueprintReadWrite)
 	FString Message;
 
+	/** Set when the operation was cancelled rather than failed */
+	UPROPERTY(Category = Gridly, VisibleAnywhere, BlueprintReadWrite)
+	bool bCancelled = false;
+
 	static const FGridlyResult Success;
+	static const FGridlyResult Cancelled;
 };
\ No newline at end of file
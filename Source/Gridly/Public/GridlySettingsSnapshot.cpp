@@ -0,0 +1,46 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlySettingsSnapshot.h"
+
+TSharedRef<const FGridlySettingsSnapshot, ESPMode::ThreadSafe> FGridlySettingsSnapshot::Capture()
+{
+	check(IsInGameThread());
+
+	const UGridlyGameSettings* GameSettings = GetDefault<UGridlyGameSettings>();
+	const TSharedRef<FGridlySettingsSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FGridlySettingsSnapshot, ESPMode::ThreadSafe>();
+
+	Snapshot->ImportApiKey = GameSettings->ImportApiKey;
+	Snapshot->ImportFromViewIds = GameSettings->ImportFromViewIds;
+	Snapshot->ImportMaxRecordsPerRequest = GameSettings->ImportMaxRecordsPerRequest;
+	Snapshot->ImportMaxConcurrentRequests = GameSettings->ImportMaxConcurrentRequests;
+	Snapshot->bCacheImportedPages = GameSettings->bCacheImportedPages;
+	Snapshot->bUseOfflineTextCache = GameSettings->bUseOfflineTextCache;
+	Snapshot->ImportTaskPoolSize = GameSettings->ImportTaskPoolSize;
+	Snapshot->ImportMaxRetriesPerPage = GameSettings->ImportMaxRetriesPerPage;
+	Snapshot->ImportRetryBaseDelay = GameSettings->ImportRetryBaseDelay;
+	Snapshot->bImportOnlyUsedColumns = GameSettings->bImportOnlyUsedColumns;
+	Snapshot->bImportDirectlyToArchives = GameSettings->bImportDirectlyToArchives;
+
+	Snapshot->bEnableLiveUpdate = GameSettings->bEnableLiveUpdate;
+	Snapshot->LiveUpdateInterval = GameSettings->LiveUpdateInterval;
+	Snapshot->LiveUpdateFrameBudgetMs = GameSettings->LiveUpdateFrameBudgetMs;
+
+	Snapshot->ExportApiKey = GameSettings->ExportApiKey;
+	Snapshot->ExportViewId = GameSettings->ExportViewId;
+	Snapshot->ExportMaxRecordsPerRequest = GameSettings->ExportMaxRecordsPerRequest;
+
+	Snapshot->bUseCombinedNamespaceId = GameSettings->bUseCombinedNamespaceId;
+	Snapshot->bAlsoExportNamespaceColumn = GameSettings->bAlsoExportNamespaceColumn;
+	Snapshot->NamespaceColumnId = GameSettings->NamespaceColumnId;
+	Snapshot->SourceLanguageColumnIdPrefix = GameSettings->SourceLanguageColumnIdPrefix;
+	Snapshot->TargetLanguageColumnIdPrefix = GameSettings->TargetLanguageColumnIdPrefix;
+	Snapshot->bUseCustomCultureMapping = GameSettings->bUseCustomCultureMapping;
+	Snapshot->CustomCultureMapping = GameSettings->CustomCultureMapping;
+	Snapshot->bExportContext = GameSettings->bExportContext;
+	Snapshot->ContextColumnId = GameSettings->ContextColumnId;
+	Snapshot->bExportMetadata = GameSettings->bExportMetadata;
+	Snapshot->MetadataMapping = GameSettings->MetadataMapping;
+	Snapshot->bSyncRecords = GameSettings->bSyncRecords;
+
+	return Snapshot;
+}
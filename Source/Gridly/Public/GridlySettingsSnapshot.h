@@ -0,0 +1,60 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridlyGameSettings.h"
+
+/**
+ * A copy of UGridlyGameSettings taken on the game thread when an import or export starts. It is never modified afterwards,
+ * so worker threads can read it while the settings object is being edited
+ */
+struct GRIDLY_API FGridlySettingsSnapshot
+{
+	// Import
+
+	FString ImportApiKey;
+	TArray<FString> ImportFromViewIds;
+	int ImportMaxRecordsPerRequest = 1000;
+	int ImportMaxConcurrentRequests = 4;
+	bool bCacheImportedPages = true;
+	bool bUseOfflineTextCache = true;
+	int ImportTaskPoolSize = 2;
+	int ImportMaxRetriesPerPage = 3;
+	float ImportRetryBaseDelay = 1.f;
+	bool bImportOnlyUsedColumns = true;
+	bool bImportDirectlyToArchives = false;
+
+	// Live Update
+
+	bool bEnableLiveUpdate = false;
+	float LiveUpdateInterval = 30.f;
+	float LiveUpdateFrameBudgetMs = 2.f;
+
+	// Export
+
+	FString ExportApiKey;
+	FString ExportViewId;
+	int ExportMaxRecordsPerRequest = 1000;
+
+	// Options
+
+	bool bUseCombinedNamespaceId = false;
+	bool bAlsoExportNamespaceColumn = false;
+	FString NamespaceColumnId;
+	FString SourceLanguageColumnIdPrefix;
+	FString TargetLanguageColumnIdPrefix;
+	bool bUseCustomCultureMapping = true;
+	TMap<FString, FString> CustomCultureMapping;
+	bool bExportContext = false;
+	FString ContextColumnId;
+	bool bExportMetadata = false;
+	TMap<FString, FGridlyColumnInfo> MetadataMapping;
+	bool bSyncRecords = true;
+
+	/** Must be called on the game thread */
+	static TSharedRef<const FGridlySettingsSnapshot, ESPMode::ThreadSafe> Capture();
+};
+
+typedef TSharedRef<const FGridlySettingsSnapshot, ESPMode::ThreadSafe> FGridlySettingsSnapshotRef;
+typedef TSharedPtr<const FGridlySettingsSnapshot, ESPMode::ThreadSafe> FGridlySettingsSnapshotPtr;
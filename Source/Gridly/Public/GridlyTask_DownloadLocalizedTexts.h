@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "GridlyResult.h"
+#include "GridlySettingsSnapshot.h"
+#include "GridlyViewCache.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Internationalization/PolyglotTextData.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
@@ -27,12 +30,40 @@ public:
 
 	virtual void Activate() override;
 
+	void RequestView(const int ViewIdIndex);
 	void RequestPage(const int ViewIdIndex, const int Offset);
-	void OnProcessRequestComplete(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess);
+	void OnProcessRequestComplete(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess, int Offset);
 
 public:
-	UFUNCTION(Category = Gridly, BlueprintCallable, meta = (BlueprintInternalUseOnly = true, WorldContext = "WorldContextObject"))
-	static UGridlyTask_DownloadLocalizedTexts* DownloadLocalizedTexts(const UObject* WorldContextObject);
+	/**
+	 * OnProgress only passes the texts of the page that just arrived. Set bKeepResult to false if the texts are consumed
+	 * from OnProgress, so they aren't also accumulated for OnSuccess
+	 */
+	UFUNCTION(Category = Gridly, BlueprintCallable,
+		meta = (BlueprintInternalUseOnly = true, WorldContext = "WorldContextObject", AdvancedDisplay = "bKeepResult"))
+	static UGridlyTask_DownloadLocalizedTexts* DownloadLocalizedTexts(const UObject* WorldContextObject, bool bKeepResult = true);
+
+	/**
+	 * Same as DownloadLocalizedTexts, but the task may come from a pool of finished tasks and goes back to it once done.
+	 * The caller must drop its pointer to the task when OnSuccess or OnFail is called, the task may be running someone
+	 * else's download after that
+	 */
+	static UGridlyTask_DownloadLocalizedTexts* DownloadLocalizedTextsPooled(const UObject* WorldContextObject, bool bKeepResult = true);
+
+	/** Lets the pooled tasks be garbage collected. Called when the module shuts down */
+	static void ReleasePool();
+
+	/** Aborts the requests in flight and releases the downloaded texts. OnFail is called with a cancelled result */
+	UFUNCTION(Category = Gridly, BlueprintCallable)
+	void Cancel();
+
+	/** The amount of records downloaded so far */
+	UFUNCTION(Category = Gridly, BlueprintPure)
+	int GetReceivedCount() const;
+
+	/** The amount of records in the views downloaded so far. Grows as each view starts downloading */
+	UFUNCTION(Category = Gridly, BlueprintPure)
+	int GetTotalCount() const;
 
 public:
 	UPROPERTY(BlueprintAssignable)
@@ -49,15 +80,54 @@ public:
 	FDownloadLocalizedTextsFailDelegate OnFailDelegate;;
 
 private:
-	FHttpRequestPtr HttpRequest;
+	void RequestPendingPages();
+	void QueueViewPages(const int ViewIdTotalCount);
+	bool RetryPage(const int Offset);
+	void OnPageConverted(const int Offset, const bool bConverted, const bool bCacheMiss, TArray<FPolyglotTextData>&& PageTexts);
+	void CancelActiveRequests();
+	void Fail(const FGridlyResult& FailResult);
+
+	/** Passes the texts saved by the last successful download to UpdateLocalizationPreview, see bUseOfflineTextCache */
+	void ApplyTextCache();
+
+	/** Releases the downloaded texts, then returns the task to the pool or lets it be garbage collected */
+	void Finish();
+
+private:
+	TMap<int, FHttpRequestPtr> ActiveRequests;
+	TArray<FTSTicker::FDelegateHandle> TickerHandles;
 	const UObject* WorldContextObject;
 
 	int Limit;
 	int TotalCount;
+	int ReceivedCount;
+	int MaxConcurrentRequests;
+	int MaxRetries;
+	float RetryBaseDelay;
 
+	FGridlySettingsSnapshotPtr Settings;
 	TArray<FString> ViewIds;
 	int CurrentViewIdIndex;
-	int CurrentOffset;
+	TArray<FString> TargetCultures;
+	FString ConversionKey;
+	FString ColumnIdsQuery;
+	bool bUseCache = false;
+	bool bIsRunning = false;
+	bool bKeepResult = true;
+	bool bPooled = false;
+	bool bUseTextCache = false;
+	uint32 RunSerial = 0;
+
+	// Pages of the current view, indexed by offset / limit so they can be merged in order
+	TArray<TArray<FPolyglotTextData>> ViewPages;
+	TArray<int> PendingOffsets;
+	int ReceivedPages;
+
+	// Validators of the cached pages being revalidated for the current view, by offset
+	TMap<int, FGridlyCachedPage> CachedPages;
+
+	TMap<int, int> RetryAttempts;
+	TMap<int, int> ThrottledAttempts;
 
 	TArray<FPolyglotTextData> PolyglotTextDatas;
 };
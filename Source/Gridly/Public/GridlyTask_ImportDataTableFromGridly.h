@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "GridlyDataTable.h"
 #include "GridlyResult.h"
+#include "GridlySettingsSnapshot.h"
 #include "GridlyTableRow.h"
+#include "GridlyViewCache.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
 
@@ -36,6 +39,18 @@ public:
 	static UGridlyTask_ImportDataTableFromGridly* ImportDataTableFromGridly(const UObject* WorldContextObject,
 		UGridlyDataTable* GridlyDataTable);
 
+	/** Aborts the request in flight and releases the downloaded rows. OnFail is called with a cancelled result */
+	UFUNCTION(Category = Gridly, BlueprintCallable)
+	void Cancel();
+
+	/** The amount of rows downloaded so far */
+	UFUNCTION(Category = Gridly, BlueprintPure)
+	int GetReceivedCount() const;
+
+	/** The amount of rows in the view. Known once the first page has arrived */
+	UFUNCTION(Category = Gridly, BlueprintPure)
+	int GetTotalCount() const;
+
 public:
 	UPROPERTY(BlueprintAssignable)
 	FImportDataTableFromGridlyDelegate OnSuccess;
@@ -50,17 +65,39 @@ public:
 	FImportDataTableFromGridlyProgressDelegate OnProgressDelegate;
 	FImportDataTableFromGridlyFailDelegate OnFailDelegate;;
 
+private:
+	void Fail(const FGridlyResult& FailResult);
+
+	/** Releases the downloaded rows and lets the task be garbage collected */
+	void Finish();
+
+	void OnPageConverted(const bool bConverted, const bool bCacheMiss, const int ViewIdTotalCount, TArray<FGridlyTableRow>&& TableRows);
+
 private:
 	FHttpRequestPtr HttpRequest;
+	FGridlySettingsSnapshotPtr Settings;
+	TArray<FTSTicker::FDelegateHandle> TickerHandles;
 	const UObject* WorldContextObject;
 
 	int Limit;
 	int TotalCount;
+	int ReceivedCount;
 
 	TArray<FString> ViewIds;
 	int CurrentViewIdIndex;
 	int CurrentOffset;
 
+	bool bIsRunning = false;
+	bool bUseCache = false;
+	bool bHasCachedPage = false;
+	FGridlyCachedPage CachedPage;
+
+
+	int MaxRetries = 0;
+	float RetryBaseDelay = 1.f;
+	int CurrentRetryAttempts = 0;
+	int CurrentThrottledAttempts = 0;
+
 	TArray<FGridlyTableRow> GridlyTableRows;
 
 	UPROPERTY()
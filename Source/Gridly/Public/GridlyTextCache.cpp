@@ -0,0 +1,72 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyTextCache.h"
+
+#include "Gridly.h"
+#include "GridlyLocalizedTextConverter.h"
+#include "GridlyViewCache.h"
+#include "Tasks/Task.h"
+
+namespace GridlyTextCache
+{
+	/** Two downloads finishing together would otherwise write the same temporary file */
+	FCriticalSection SaveLock;
+}
+
+TSharedPtr<const FGridlyTextStore, ESPMode::ThreadSafe> FGridlyTextCache::Open(const FString& CacheKey)
+{
+	return FGridlyTextStore::Open(GetPath(), CacheKey);
+}
+
+static bool HoldsSameTexts(const FGridlyTextStore& TextStore, const TArray<FPolyglotTextData>& PolyglotTextDatas)
+{
+	if (TextStore.Num() != PolyglotTextDatas.Num())
+	{
+		return false;
+	}
+
+	for (const FPolyglotTextData& PolyglotTextData : PolyglotTextDatas)
+	{
+		const int32 Index = TextStore.FindText(PolyglotTextData.GetNamespace(), PolyglotTextData.GetKey());
+		if (Index == INDEX_NONE || TextStore.GetContentHash(Index) != FGridlyLocalizedTextConverter::HashPolyglotTextData(PolyglotTextData))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FGridlyTextCache::Save(const FString& CacheKey, const TArray<FPolyglotTextData>& PolyglotTextDatas)
+{
+	FScopeLock Lock(&GridlyTextCache::SaveLock);
+
+	// The store is closed again before the file is replaced, a mapped file can't be replaced on every platform
+	{
+		const TSharedPtr<const FGridlyTextStore, ESPMode::ThreadSafe> TextStore = Open(CacheKey);
+		if (TextStore.IsValid() && HoldsSameTexts(*TextStore, PolyglotTextDatas))
+		{
+			return true;
+		}
+	}
+
+	return FGridlyTextStore::Write(GetPath(), CacheKey, PolyglotTextDatas);
+}
+
+void FGridlyTextCache::SaveAsync(const FString& CacheKey, TArray<FPolyglotTextData>&& PolyglotTextDatas)
+{
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [CacheKey, PolyglotTextDatas = MoveTemp(PolyglotTextDatas)]()
+	{
+		Save(CacheKey, PolyglotTextDatas);
+	});
+}
+
+FString FGridlyTextCache::GetCacheKey(const TArray<FString>& ViewIds, const FString& ConversionKey)
+{
+	return FString::Join(ViewIds, TEXT(",")) + TEXT("|") + ConversionKey;
+}
+
+FString FGridlyTextCache::GetPath()
+{
+	return FGridlyViewCache::GetCacheDir() / TEXT("Texts.store");
+}
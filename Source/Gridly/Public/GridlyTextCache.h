@@ -0,0 +1,30 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridlyTextStore.h"
+#include "Internationalization/PolyglotTextData.h"
+
+/**
+ * Keeps the texts of the last successful runtime download in Saved/Gridly/Cache/Texts.store, so the next launch has them
+ * before its own download finishes, or when it can't reach Gridly at all.
+ * The file is an FGridlyTextStore tagged with the view IDs and conversion key it was made with, a change in either makes
+ * it stale. All functions are thread safe.
+ */
+class GRIDLY_API FGridlyTextCache
+{
+public:
+	/** Returns nullptr if there are no cached texts for this cache key */
+	static TSharedPtr<const FGridlyTextStore, ESPMode::ThreadSafe> Open(const FString& CacheKey);
+
+	/** Leaves the file alone if it already holds the same texts */
+	static bool Save(const FString& CacheKey, const TArray<FPolyglotTextData>& PolyglotTextDatas);
+
+	/** Saves on a worker thread. The texts are moved into the task */
+	static void SaveAsync(const FString& CacheKey, TArray<FPolyglotTextData>&& PolyglotTextDatas);
+
+	static FString GetCacheKey(const TArray<FString>& ViewIds, const FString& ConversionKey);
+
+	static FString GetPath();
+};
@@ -0,0 +1,47 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyTextRegistry.h"
+
+#include "GridlyLocalizedTextConverter.h"
+
+namespace GridlyTextRegistry
+{
+	FCriticalSection Lock;
+
+	/** Hash of "{Namespace},{Key}" -> hash of the strings last registered */
+	TMap<uint64, uint64> ContentHashes;
+}
+
+bool FGridlyTextRegistry::Update(const FPolyglotTextData& PolyglotTextData)
+{
+	return Update(FGridlyLocalizedTextConverter::HashTextId(PolyglotTextData.GetNamespace(), PolyglotTextData.GetKey()),
+		FGridlyLocalizedTextConverter::HashPolyglotTextData(PolyglotTextData));
+}
+
+bool FGridlyTextRegistry::Update(const uint64 IdHash, const uint64 ContentHash)
+{
+	FScopeLock Lock(&GridlyTextRegistry::Lock);
+
+	uint64& RegisteredHash = GridlyTextRegistry::ContentHashes.FindOrAdd(IdHash, ~ContentHash);
+	if (RegisteredHash == ContentHash)
+	{
+		return false;
+	}
+
+	RegisteredHash = ContentHash;
+	return true;
+}
+
+bool FGridlyTextRegistry::IsChanged(const uint64 IdHash, const uint64 ContentHash)
+{
+	FScopeLock Lock(&GridlyTextRegistry::Lock);
+
+	const uint64* RegisteredHash = GridlyTextRegistry::ContentHashes.Find(IdHash);
+	return !RegisteredHash || *RegisteredHash != ContentHash;
+}
+
+void FGridlyTextRegistry::Reset()
+{
+	FScopeLock Lock(&GridlyTextRegistry::Lock);
+	GridlyTextRegistry::ContentHashes.Empty();
+}
@@ -0,0 +1,31 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/PolyglotTextData.h"
+
+/**
+ * Remembers which version of each text has been registered with the localization manager, so UpdateLocalizationPreview
+ * and the live update subsystem only register the texts that changed, whichever of them registered the last version.
+ * A text is kept as the hash of its namespace and key and the hash of its strings, 16 bytes instead of its strings.
+ * All functions are thread safe.
+ */
+class GRIDLY_API FGridlyTextRegistry
+{
+public:
+	/** Records the text as registered. Returns false if the same version was registered already */
+	static bool Update(const FPolyglotTextData& PolyglotTextData);
+
+	/** Same as above, with the hashes made by FGridlyLocalizedTextConverter::HashTextId and HashPolyglotTextData */
+	static bool Update(const uint64 IdHash, const uint64 ContentHash);
+
+	/**
+	 * Returns true if this version of the text hasn't been registered. Records nothing, so a text that ends up not being
+	 * registered isn't counted as registered. Call Update once it has been
+	 */
+	static bool IsChanged(const uint64 IdHash, const uint64 ContentHash);
+
+	/** Forgets every text, so the next update registers them all again */
+	static void Reset();
+};
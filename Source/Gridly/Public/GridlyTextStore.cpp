@@ -0,0 +1,437 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyTextStore.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "Gridly.h"
+#include "GridlyLocalizedTextConverter.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Internationalization/LocKeyFuncs.h"
+#include "Misc/FileHelper.h"
+
+namespace GridlyTextStore
+{
+	constexpr uint32 Magic = 0x47524453; // "GRDS"
+
+	/** Bump when the file layout changes */
+	constexpr uint32 Version = 1;
+
+	/** Offset of a translation that doesn't exist */
+	constexpr uint32 NoString = MAX_uint32;
+
+	// Strings are stored as TCHARs, so they can be viewed in place
+	static_assert(sizeof(TCHAR) == 2, "The text store expects UTF-16 TCHARs");
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 NumTexts;
+		uint32 NumCultures;
+		uint32 CacheKey;
+		uint32 CulturesOffset;
+		uint32 EntriesOffset;
+		uint32 TranslationsOffset;
+		uint32 StringsOffset;
+		uint32 StringsSize;
+	};
+
+	/** Sorted by IdHash. Every string is an offset into the string pool */
+	struct FEntry
+	{
+		uint64 IdHash;
+		uint64 ContentHash;
+		uint32 Namespace;
+		uint32 Key;
+		uint32 NativeString;
+		uint16 NativeCulture;
+		uint8 Category;
+		uint8 Padding;
+	};
+
+	static_assert(sizeof(FEntry) == 32, "FEntry is written as is");
+
+	/**
+	 * Interns strings into the pool, each stored as its length followed by its characters, aligned to 4 bytes.
+	 * Keyed by FLocKey since FString keys compare case-insensitively, and "OK" and "Ok" must stay two strings
+	 */
+	class FStringPoolWriter
+	{
+	public:
+		uint32 Add(const FString& String)
+		{
+			const FLocKey StringKey(String);
+			if (const uint32* Offset = Offsets.Find(StringKey))
+			{
+				return *Offset;
+			}
+
+			const uint32 Offset = Pool.Num();
+			const uint32 Len = String.Len();
+			Pool.Append(reinterpret_cast<const uint8*>(&Len), sizeof(Len));
+			Pool.Append(reinterpret_cast<const uint8*>(*String), Len * sizeof(TCHAR));
+			Pool.AddZeroed(Align(Pool.Num(), 4) - Pool.Num());
+
+			Offsets.Add(StringKey, Offset);
+			return Offset;
+		}
+
+		TArray<uint8> Pool;
+
+	private:
+		TMap<FLocKey, uint32> Offsets;
+	};
+
+	template <typename T>
+	void Append(TArray<uint8>& Blob, const TArray<T>& Items)
+	{
+		Blob.Append(reinterpret_cast<const uint8*>(Items.GetData()), Items.Num() * sizeof(T));
+	}
+}
+
+FGridlyTextStore::~FGridlyTextStore() = default;
+
+bool FGridlyTextStore::Write(const FString& Path, const FString& CacheKey, const TArray<FPolyglotTextData>& PolyglotTextDatas)
+{
+	using namespace GridlyTextStore;
+
+	FStringPoolWriter Strings;
+
+	TArray<FString> Cultures;
+	for (const FPolyglotTextData& PolyglotTextData : PolyglotTextDatas)
+	{
+		Cultures.AddUnique(PolyglotTextData.GetNativeCulture());
+		for (const FString& Culture : PolyglotTextData.GetLocalizedCultures())
+		{
+			Cultures.AddUnique(Culture);
+		}
+	}
+
+	if (Cultures.Num() > MAX_uint16)
+	{
+		UE_LOG(LogGridly, Warning, TEXT("Too many cultures to write the text store: %s"), *Path);
+		return false;
+	}
+
+	TArray<uint32> CultureOffsets;
+	for (const FString& Culture : Cultures)
+	{
+		CultureOffsets.Add(Strings.Add(Culture));
+	}
+
+	TArray<FEntry> Entries;
+	Entries.Reserve(PolyglotTextDatas.Num());
+	for (const FPolyglotTextData& PolyglotTextData : PolyglotTextDatas)
+	{
+		FEntry& Entry = Entries.AddZeroed_GetRef();
+		Entry.IdHash = FGridlyLocalizedTextConverter::HashTextId(PolyglotTextData.GetNamespace(), PolyglotTextData.GetKey());
+		Entry.ContentHash = FGridlyLocalizedTextConverter::HashPolyglotTextData(PolyglotTextData);
+		Entry.Namespace = Strings.Add(PolyglotTextData.GetNamespace());
+		Entry.Key = Strings.Add(PolyglotTextData.GetKey());
+		Entry.NativeString = Strings.Add(PolyglotTextData.GetNativeString());
+		Entry.NativeCulture = static_cast<uint16>(Cultures.IndexOfByKey(PolyglotTextData.GetNativeCulture()));
+		Entry.Category = static_cast<uint8>(PolyglotTextData.GetCategory());
+	}
+
+	// The entries are sorted through an index, so the translations can be looked up from the texts in the same order
+	TArray<int32> Order;
+	Order.SetNumUninitialized(Entries.Num());
+	for (int32 i = 0; i < Order.Num(); i++)
+	{
+		Order[i] = i;
+	}
+	Order.Sort([&Entries](const int32 A, const int32 B) { return Entries[A].IdHash < Entries[B].IdHash; });
+
+	TArray<FEntry> SortedEntries;
+	SortedEntries.Reserve(Entries.Num());
+
+	TArray<uint32> Translations;
+	Translations.Reserve(Entries.Num() * Cultures.Num());
+
+	FString LocalizedString;
+	for (const int32 TextIndex : Order)
+	{
+		SortedEntries.Add(Entries[TextIndex]);
+
+		const FPolyglotTextData& PolyglotTextData = PolyglotTextDatas[TextIndex];
+		for (const FString& Culture : Cultures)
+		{
+			LocalizedString.Reset();
+			Translations.Add(PolyglotTextData.GetLocalizedString(Culture, LocalizedString) ? Strings.Add(LocalizedString) : NoString);
+		}
+	}
+
+	const uint32 CacheKeyOffset = Strings.Add(CacheKey);
+
+	// Every section is a multiple of 4 bytes, which keeps the entries and strings aligned
+
+	FHeader Header;
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.NumTexts = SortedEntries.Num();
+	Header.NumCultures = Cultures.Num();
+	Header.CacheKey = CacheKeyOffset;
+	Header.EntriesOffset = Align(sizeof(FHeader), alignof(FEntry));
+	Header.CulturesOffset = Header.EntriesOffset + SortedEntries.Num() * sizeof(FEntry);
+	Header.TranslationsOffset = Header.CulturesOffset + CultureOffsets.Num() * sizeof(uint32);
+	Header.StringsOffset = Header.TranslationsOffset + Translations.Num() * sizeof(uint32);
+	Header.StringsSize = Strings.Pool.Num();
+
+	TArray<uint8> Blob;
+	Blob.Reserve(Header.StringsOffset + Header.StringsSize);
+	Blob.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	Blob.AddZeroed(Header.EntriesOffset - Blob.Num());
+	Append(Blob, SortedEntries);
+	Append(Blob, CultureOffsets);
+	Append(Blob, Translations);
+	Append(Blob, Strings.Pool);
+
+	// Written next to the final file first, so a crash never leaves a truncated store behind
+
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Blob, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+	{
+		IFileManager::Get().Delete(*TempPath, false, true, true);
+		UE_LOG(LogGridly, Warning, TEXT("Failed to write text store: %s"), *Path);
+		return false;
+	}
+
+	return true;
+}
+
+TSharedPtr<const FGridlyTextStore, ESPMode::ThreadSafe> FGridlyTextStore::Open(const FString& Path, const FString& CacheKey)
+{
+	TSharedPtr<FGridlyTextStore, ESPMode::ThreadSafe> TextStore = MakeShareable(new FGridlyTextStore());
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*Path);
+	if (!MappedResult.HasError())
+	{
+		TextStore->MappedHandle = MappedResult.StealValue();
+		TextStore->MappedRegion.Reset(TextStore->MappedHandle->MapRegion());
+		if (TextStore->MappedRegion)
+		{
+			TextStore->Data = TextStore->MappedRegion->GetMappedPtr();
+			TextStore->Size = TextStore->MappedRegion->GetMappedSize();
+		}
+	}
+
+	// Not every platform can map files
+	if (!TextStore->Data)
+	{
+		TextStore->MappedRegion.Reset();
+		TextStore->MappedHandle.Reset();
+
+		if (!FFileHelper::LoadFileToArray(TextStore->Buffer, *Path, FILEREAD_Silent))
+		{
+			return nullptr;
+		}
+
+		TextStore->Data = TextStore->Buffer.GetData();
+		TextStore->Size = TextStore->Buffer.Num();
+	}
+
+	if (!TextStore->Validate(CacheKey))
+	{
+		return nullptr;
+	}
+
+	return TextStore;
+}
+
+bool FGridlyTextStore::Validate(const FString& CacheKey)
+{
+	using namespace GridlyTextStore;
+
+	if (Size < static_cast<int64>(sizeof(FHeader)) || !IsAligned(Data, alignof(FEntry)))
+	{
+		return false;
+	}
+
+	const FHeader& Header = *reinterpret_cast<const FHeader*>(Data);
+	if (Header.Magic != Magic || Header.Version != Version)
+	{
+		return false;
+	}
+
+	// The sections must be where Write() puts them, so the accessors only need to check string offsets
+
+	const uint64 EntriesSize = static_cast<uint64>(Header.NumTexts) * sizeof(FEntry);
+	const uint64 CulturesSize = static_cast<uint64>(Header.NumCultures) * sizeof(uint32);
+	const uint64 TranslationsSize = static_cast<uint64>(Header.NumTexts) * Header.NumCultures * sizeof(uint32);
+
+	if (Header.EntriesOffset != Align(sizeof(FHeader), alignof(FEntry))
+		|| Header.CulturesOffset != Header.EntriesOffset + EntriesSize
+		|| Header.TranslationsOffset != Header.CulturesOffset + CulturesSize
+		|| Header.StringsOffset != Header.TranslationsOffset + TranslationsSize
+		|| static_cast<uint64>(Header.StringsOffset) + Header.StringsSize > static_cast<uint64>(Size))
+	{
+		UE_LOG(LogGridly, Warning, TEXT("Ignoring damaged text store"));
+		return false;
+	}
+
+	if (!GetString(Header.CacheKey).Equals(CacheKey, ESearchCase::CaseSensitive))
+	{
+		UE_LOG(LogGridly, Log, TEXT("Ignoring text store, the views or import settings have changed since it was written"));
+		return false;
+	}
+
+	return true;
+}
+
+FStringView FGridlyTextStore::GetString(const uint32 Offset) const
+{
+	using namespace GridlyTextStore;
+
+	const FHeader& Header = *reinterpret_cast<const FHeader*>(Data);
+	if (Offset % 4 != 0 || static_cast<uint64>(Offset) + sizeof(uint32) > Header.StringsSize)
+	{
+		return FStringView();
+	}
+
+	const uint8* String = Data + Header.StringsOffset + Offset;
+	const uint32 Len = *reinterpret_cast<const uint32*>(String);
+	if (static_cast<uint64>(Offset) + sizeof(uint32) + static_cast<uint64>(Len) * sizeof(TCHAR) > Header.StringsSize)
+	{
+		return FStringView();
+	}
+
+	return FStringView(reinterpret_cast<const TCHAR*>(String + sizeof(uint32)), Len);
+}
+
+int32 FGridlyTextStore::Num() const
+{
+	return reinterpret_cast<const GridlyTextStore::FHeader*>(Data)->NumTexts;
+}
+
+int32 FGridlyTextStore::FindText(FStringView Namespace, FStringView Key) const
+{
+	using namespace GridlyTextStore;
+
+	const FHeader& Header = *reinterpret_cast<const FHeader*>(Data);
+	const TArrayView<const FEntry> Entries(reinterpret_cast<const FEntry*>(Data + Header.EntriesOffset), Header.NumTexts);
+
+	const uint64 IdHash = FGridlyLocalizedTextConverter::HashTextId(Namespace, Key);
+	for (int32 Index = Algo::LowerBoundBy(Entries, IdHash, &FEntry::IdHash); Index < Entries.Num() && Entries[Index].IdHash == IdHash;
+		Index++)
+	{
+		// Namespaces and keys are case-sensitive, like FLocKey
+		if (GetString(Entries[Index].Namespace).Equals(Namespace, ESearchCase::CaseSensitive)
+			&& GetString(Entries[Index].Key).Equals(Key, ESearchCase::CaseSensitive))
+		{
+			return Index;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+static const GridlyTextStore::FEntry& GetEntry(const uint8* Data, const int32 Index)
+{
+	const GridlyTextStore::FHeader& Header = *reinterpret_cast<const GridlyTextStore::FHeader*>(Data);
+	check(Index >= 0 && static_cast<uint32>(Index) < Header.NumTexts);
+	return reinterpret_cast<const GridlyTextStore::FEntry*>(Data + Header.EntriesOffset)[Index];
+}
+
+ELocalizedTextSourceCategory FGridlyTextStore::GetCategory(const int32 Index) const
+{
+	return static_cast<ELocalizedTextSourceCategory>(GetEntry(Data, Index).Category);
+}
+
+FStringView FGridlyTextStore::GetNamespace(const int32 Index) const
+{
+	return GetString(GetEntry(Data, Index).Namespace);
+}
+
+FStringView FGridlyTextStore::GetKey(const int32 Index) const
+{
+	return GetString(GetEntry(Data, Index).Key);
+}
+
+FStringView FGridlyTextStore::GetNativeString(const int32 Index) const
+{
+	return GetString(GetEntry(Data, Index).NativeString);
+}
+
+FStringView FGridlyTextStore::GetNativeCulture(const int32 Index) const
+{
+	return GetCulture(GetEntry(Data, Index).NativeCulture);
+}
+
+uint64 FGridlyTextStore::GetIdHash(const int32 Index) const
+{
+	return GetEntry(Data, Index).IdHash;
+}
+
+uint64 FGridlyTextStore::GetContentHash(const int32 Index) const
+{
+	return GetEntry(Data, Index).ContentHash;
+}
+
+int32 FGridlyTextStore::NumCultures() const
+{
+	return reinterpret_cast<const GridlyTextStore::FHeader*>(Data)->NumCultures;
+}
+
+FStringView FGridlyTextStore::GetCulture(const int32 CultureIndex) const
+{
+	const GridlyTextStore::FHeader& Header = *reinterpret_cast<const GridlyTextStore::FHeader*>(Data);
+	if (CultureIndex < 0 || static_cast<uint32>(CultureIndex) >= Header.NumCultures)
+	{
+		return FStringView();
+	}
+
+	return GetString(reinterpret_cast<const uint32*>(Data + Header.CulturesOffset)[CultureIndex]);
+}
+
+int32 FGridlyTextStore::FindCulture(FStringView Culture) const
+{
+	for (int32 CultureIndex = 0; CultureIndex < NumCultures(); CultureIndex++)
+	{
+		if (GetCulture(CultureIndex) == Culture)
+		{
+			return CultureIndex;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+bool FGridlyTextStore::GetLocalizedString(const int32 Index, const int32 CultureIndex, FStringView& OutString) const
+{
+	const GridlyTextStore::FHeader& Header = *reinterpret_cast<const GridlyTextStore::FHeader*>(Data);
+	check(Index >= 0 && static_cast<uint32>(Index) < Header.NumTexts);
+	if (CultureIndex < 0 || static_cast<uint32>(CultureIndex) >= Header.NumCultures)
+	{
+		return false;
+	}
+
+	const uint32* Translations = reinterpret_cast<const uint32*>(Data + Header.TranslationsOffset);
+	const uint32 Offset = Translations[static_cast<int64>(Index) * Header.NumCultures + CultureIndex];
+	if (Offset == GridlyTextStore::NoString)
+	{
+		return false;
+	}
+
+	OutString = GetString(Offset);
+	return true;
+}
+
+FPolyglotTextData FGridlyTextStore::MakePolyglotTextData(const int32 Index) const
+{
+	FPolyglotTextData PolyglotTextData(GetCategory(Index), FString(GetNamespace(Index)), FString(GetKey(Index)),
+		FString(GetNativeString(Index)), FString(GetNativeCulture(Index)));
+
+	FStringView LocalizedString;
+	for (int32 CultureIndex = 0; CultureIndex < NumCultures(); CultureIndex++)
+	{
+		if (GetLocalizedString(Index, CultureIndex, LocalizedString))
+		{
+			PolyglotTextData.AddLocalizedString(FString(GetCulture(CultureIndex)), FString(LocalizedString));
+		}
+	}
+
+	return PolyglotTextData;
+}
@@ -0,0 +1,73 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/PolyglotTextData.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * A read-only store of localized texts, read straight from a memory-mapped file instead of being loaded into
+ * FPolyglotTextData, which allocates a map and several strings per text.
+ * The file holds the texts sorted by the hash of their namespace and key, a table with the offset of every translation
+ * by text and culture, and a pool of deduplicated strings. Strings are returned as views into the mapped file, valid
+ * for as long as the store is alive. A store can be read from any thread.
+ */
+class GRIDLY_API FGridlyTextStore
+{
+public:
+	~FGridlyTextStore();
+
+	static bool Write(const FString& Path, const FString& CacheKey, const TArray<FPolyglotTextData>& PolyglotTextDatas);
+
+	/** Returns nullptr if the file is missing, was written with another cache key, or is damaged */
+	static TSharedPtr<const FGridlyTextStore, ESPMode::ThreadSafe> Open(const FString& Path, const FString& CacheKey);
+
+	int32 Num() const;
+
+	/** Returns the index of a text, or INDEX_NONE */
+	int32 FindText(FStringView Namespace, FStringView Key) const;
+
+	ELocalizedTextSourceCategory GetCategory(const int32 Index) const;
+	FStringView GetNamespace(const int32 Index) const;
+	FStringView GetKey(const int32 Index) const;
+	FStringView GetNativeString(const int32 Index) const;
+	FStringView GetNativeCulture(const int32 Index) const;
+
+	/** FGridlyLocalizedTextConverter::HashTextId of the text */
+	uint64 GetIdHash(const int32 Index) const;
+
+	/** FGridlyLocalizedTextConverter::HashPolyglotTextData of the text, stored when the file was written */
+	uint64 GetContentHash(const int32 Index) const;
+
+	int32 NumCultures() const;
+	FStringView GetCulture(const int32 CultureIndex) const;
+
+	/** Returns the index of a culture, or INDEX_NONE */
+	int32 FindCulture(FStringView Culture) const;
+
+	/** Returns false if the text has no translation for the culture */
+	bool GetLocalizedString(const int32 Index, const int32 CultureIndex, FStringView& OutString) const;
+
+	/** Copies a single text out of the store, for APIs that need an FPolyglotTextData */
+	FPolyglotTextData MakePolyglotTextData(const int32 Index) const;
+
+private:
+	FGridlyTextStore() = default;
+
+	bool Validate(const FString& CacheKey);
+	FStringView GetString(const uint32 Offset) const;
+
+private:
+	// Declared before the region, which must be unmapped before the file is closed
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	// Used instead of the mapping on platforms that can't map files
+	TArray<uint8> Buffer;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+};
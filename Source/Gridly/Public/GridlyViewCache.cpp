@@ -0,0 +1,141 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyViewCache.h"
+
+#include "Gridly.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+namespace GridlyViewCache
+{
+	constexpr uint32 Magic = 0x47524443; // "GRDC"
+
+	/** Bump when the file layout changes. Payload formats are versioned through the conversion key */
+	constexpr int32 Version = 1;
+}
+
+bool FGridlyViewCache::LoadValidators(const FString& ViewId, const int Offset, const int Limit, const FString& ConversionKey,
+	FGridlyCachedPage& OutPage)
+{
+	return ReadPage(ViewId, Offset, Limit, ConversionKey, OutPage, false);
+}
+
+bool FGridlyViewCache::LoadPage(const FString& ViewId, const int Offset, const int Limit, const FString& ConversionKey,
+	FGridlyCachedPage& OutPage)
+{
+	return ReadPage(ViewId, Offset, Limit, ConversionKey, OutPage, true);
+}
+
+bool FGridlyViewCache::SavePage(const FString& ViewId, const int Offset, const int Limit, const FString& ConversionKey,
+	FGridlyCachedPage& Page)
+{
+	const FString Path = GetPagePath(ViewId, Offset, Limit);
+
+	// Written next to the final file first, so a crash never leaves a truncated page behind. The temp file is unique,
+	// as two tasks may be saving the same page at the same time
+
+	const FString TempPath = FString::Printf(TEXT("%s.%s.tmp"), *Path, *FGuid::NewGuid().ToString());
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+	if (!Writer)
+	{
+		UE_LOG(LogGridly, Warning, TEXT("Failed to write cached page: %s"), *Path);
+		return false;
+	}
+
+	uint32 Magic = GridlyViewCache::Magic;
+	int32 Version = GridlyViewCache::Version;
+	FString Key = ConversionKey;
+
+	*Writer << Magic << Version << Key;
+	*Writer << Page.ETag << Page.LastModified << Page.ContentHash << Page.TotalCount;
+	*Writer << Page.Payload;
+
+	const bool bWritten = Writer->Close() && !Writer->IsError();
+	Writer.Reset();
+
+	if (!bWritten || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+	{
+		IFileManager::Get().Delete(*TempPath, false, true, true);
+		UE_LOG(LogGridly, Warning, TEXT("Failed to write cached page: %s"), *Path);
+		return false;
+	}
+
+	return true;
+}
+
+void FGridlyViewCache::RemovePage(const FString& ViewId, const int Offset, const int Limit)
+{
+	IFileManager::Get().Delete(*GetPagePath(ViewId, Offset, Limit), false, true, true);
+}
+
+void FGridlyViewCache::AddConditionalHeaders(const FHttpRequestPtr& HttpRequest, const FGridlyCachedPage& Page)
+{
+	if (!Page.ETag.IsEmpty())
+	{
+		HttpRequest->SetHeader(TEXT("If-None-Match"), Page.ETag);
+	}
+
+	if (!Page.LastModified.IsEmpty())
+	{
+		HttpRequest->SetHeader(TEXT("If-Modified-Since"), Page.LastModified);
+	}
+}
+
+void FGridlyViewCache::ReadValidators(const FHttpResponsePtr& HttpResponsePtr, FGridlyCachedPage& OutPage)
+{
+	OutPage.ETag = HttpResponsePtr->GetHeader(TEXT("ETag"));
+	OutPage.LastModified = HttpResponsePtr->GetHeader(TEXT("Last-Modified"));
+	OutPage.TotalCount = FCString::Atoi(*HttpResponsePtr->GetHeader(TEXT("X-Total-Count")));
+
+	const TArray<uint8>& Content = HttpResponsePtr->GetContent();
+	FSHAHash Hash;
+	FSHA1::HashBuffer(Content.GetData(), Content.Num(), Hash.Hash);
+	OutPage.ContentHash = Hash.ToString();
+}
+
+FString FGridlyViewCache::GetCacheDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Gridly") / TEXT("Cache");
+}
+
+FString FGridlyViewCache::GetPagePath(const FString& ViewId, const int Offset, const int Limit)
+{
+	return GetCacheDir() / FPaths::MakeValidFileName(ViewId) / FString::Printf(TEXT("%d_%d.page"), Offset, Limit);
+}
+
+bool FGridlyViewCache::ReadPage(const FString& ViewId, const int Offset, const int Limit, const FString& ConversionKey,
+	FGridlyCachedPage& OutPage, const bool bWithPayload)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetPagePath(ViewId, Offset, Limit), FILEREAD_Silent));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	FString Key;
+
+	*Reader << Magic << Version;
+	if (Magic != GridlyViewCache::Magic || Version != GridlyViewCache::Version)
+	{
+		return false;
+	}
+
+	*Reader << Key;
+	if (Key != ConversionKey)
+	{
+		return false;
+	}
+
+	*Reader << OutPage.ETag << OutPage.LastModified << OutPage.ContentHash << OutPage.TotalCount;
+	if (bWithPayload)
+	{
+		*Reader << OutPage.Payload;
+	}
+
+	return !Reader->IsError();
+}
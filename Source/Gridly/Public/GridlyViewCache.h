@@ -0,0 +1,60 @@
+﻿// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+
+/** A record page as stored in the view cache */
+struct GRIDLY_API FGridlyCachedPage
+{
+	/** Validators returned by Gridly for this page, used to revalidate it */
+	FString ETag;
+	FString LastModified;
+
+	/** SHA1 of the raw response body, used when the server doesn't honor the validators */
+	FString ContentHash;
+
+	/** The X-Total-Count of the view when the page was downloaded */
+	int32 TotalCount = 0;
+
+	/** The already converted page data. The format is up to the task that stored it */
+	TArray<uint8> Payload;
+};
+
+/**
+ * Stores downloaded record pages under Saved/Gridly/Cache/{ViewId}, so later imports can revalidate them with
+ * conditional requests instead of downloading and parsing everything again. This is also what lets an interrupted
+ * import pick up where it stopped: its finished pages come back as 304s.
+ * Pages are keyed by offset and limit, and tagged with a conversion key so a change in the import settings
+ * invalidates the converted data. All functions are thread safe.
+ */
+class GRIDLY_API FGridlyViewCache
+{
+public:
+	/** Reads a cached page without its payload. Returns false if the page isn't cached for this conversion key */
+	static bool LoadValidators(const FString& ViewId, const int Offset, const int Limit, const FString& ConversionKey,
+		FGridlyCachedPage& OutPage);
+
+	/** Reads a cached page including its payload */
+	static bool LoadPage(const FString& ViewId, const int Offset, const int Limit, const FString& ConversionKey,
+		FGridlyCachedPage& OutPage);
+
+	static bool SavePage(const FString& ViewId, const int Offset, const int Limit, const FString& ConversionKey,
+		FGridlyCachedPage& Page);
+
+	static void RemovePage(const FString& ViewId, const int Offset, const int Limit);
+
+	/** Adds If-None-Match / If-Modified-Since for the validators of a cached page */
+	static void AddConditionalHeaders(const FHttpRequestPtr& HttpRequest, const FGridlyCachedPage& Page);
+
+	/** Fills the validators of a page from a response. The payload is left untouched */
+	static void ReadValidators(const FHttpResponsePtr& HttpResponsePtr, FGridlyCachedPage& OutPage);
+
+	static FString GetCacheDir();
+
+private:
+	static FString GetPagePath(const FString& ViewId, const int Offset, const int Limit);
+	static bool ReadPage(const FString& ViewId, const int Offset, const int Limit, const FString& ConversionKey,
+		FGridlyCachedPage& OutPage, const bool bWithPayload);
+};
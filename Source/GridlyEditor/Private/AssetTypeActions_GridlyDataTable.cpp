@@ -286,7 +286,7 @@ void FAssetTypeActions_GridlyDataTable::ImportFromGridly(UGridlyDataTable* DataT
 		LOCTEXT("ImportGridlyDataTableSlowTask", "Importing data table from Gridly")));
 	auto& SlowTask = ImportSlowTasks.Add(DataTable->GetUniqueID(), ImportDataTableFromGridlySlowTask);
 
-	SlowTask->MakeDialog();
+	SlowTask->MakeDialog(true);
 
 	UGridlyTask_ImportDataTableFromGridly* Task =
 		UGridlyTask_ImportDataTableFromGridly::ImportDataTableFromGridly(nullptr, GridlyDataTable);
@@ -294,8 +294,14 @@ void FAssetTypeActions_GridlyDataTable::ImportFromGridly(UGridlyDataTable* DataT
 	FDataTableEditorUtils::BroadcastPreChange(GridlyDataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
 
 	Task->OnProgressDelegate.BindLambda(
-		[GridlyDataTable, &SlowTask](const TArray<FGridlyTableRow>& GridlyTableRows, float Progress) mutable
+		[GridlyDataTable, Task, &SlowTask](const TArray<FGridlyTableRow>& GridlyTableRows, float Progress) mutable
 		{
+			if (SlowTask->ShouldCancel())
+			{
+				Task->Cancel();
+				return;
+			}
+
 			const float Delta = Progress - SlowTask->CompletedWork;
 			SlowTask->EnterProgressFrame(Delta);
 		});
@@ -314,6 +320,11 @@ void FAssetTypeActions_GridlyDataTable::ImportFromGridly(UGridlyDataTable* DataT
 			SlowTask.Reset();
 			FDataTableEditorUtils::BroadcastPostChange(GridlyDataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
 
+			if (GridlyResult.bCancelled)
+			{
+				return;
+			}
+
 			const FString ErrorMessage = GridlyResult.Message;
 			UE_LOG(LogGridlyEditor, Error, TEXT("%s"), *ErrorMessage);
 			FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(ErrorMessage));
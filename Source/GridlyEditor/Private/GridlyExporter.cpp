@@ -3,20 +3,21 @@
 #include "GridlyCultureConverter.h"
 #include "GridlyDataTableImporterJSON.h"
 #include "GridlyGameSettings.h"
+#include "GridlySettingsSnapshot.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Internationalization/PolyglotTextData.h"
 #include "LocTextHelper.h"
 
-bool FGridlyExporter::ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTextDatas,
+bool FGridlyExporter::ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTextDatas, const FGridlySettingsSnapshot& Settings,
 	bool bIncludeTargetTranslations, const TSharedPtr<FLocTextHelper>& LocTextHelperPtr, FString& OutJsonString)
 {
-	UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
 	const TArray<FString> TargetCultures = FGridlyCultureConverter::GetTargetCultures();
+	const FGridlyCultureConverter CultureConverter(Settings, TargetCultures);
 
-	const bool bUseCombinedNamespaceKey = GameSettings->bUseCombinedNamespaceId;
-	const bool bExportNamespace = !bUseCombinedNamespaceKey || GameSettings->bAlsoExportNamespaceColumn;
-	const bool bUsePathAsNamespace = GameSettings->NamespaceColumnId == "path";
+	const bool bUseCombinedNamespaceKey = Settings.bUseCombinedNamespaceId;
+	const bool bExportNamespace = !bUseCombinedNamespaceKey || Settings.bAlsoExportNamespaceColumn;
+	const bool bUsePathAsNamespace = Settings.NamespaceColumnId == "path";
 
 	TArray<TSharedPtr<FJsonValue>> Rows;
 
@@ -61,10 +62,10 @@ bool FGridlyExporter::ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTex
 			{
 				RowJsonObject->SetStringField("path", Namespace);
 			}
-			else if (!GameSettings->NamespaceColumnId.IsEmpty())
+			else if (!Settings.NamespaceColumnId.IsEmpty())
 			{
 				TSharedPtr<FJsonObject> CellJsonObject = MakeShareable(new FJsonObject);
-				CellJsonObject->SetStringField("columnId", GameSettings->NamespaceColumnId);
+				CellJsonObject->SetStringField("columnId", Settings.NamespaceColumnId);
 				CellJsonObject->SetStringField("value", Namespace);
 				CellsJsonArray.Add(MakeShareable(new FJsonValueObject(CellJsonObject)));
 			}
@@ -77,20 +78,20 @@ bool FGridlyExporter::ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTex
 			const FString NativeString = PolyglotTextDatas[i].GetNativeString();
 
 			FString GridlyCulture;
-			if (FGridlyCultureConverter::ConvertToGridly(NativeCulture, GridlyCulture))
+			if (CultureConverter.ToGridly(NativeCulture, GridlyCulture))
 			{
 				TSharedPtr<FJsonObject> CellJsonObject = MakeShareable(new FJsonObject);
-				CellJsonObject->SetStringField("columnId", GameSettings->SourceLanguageColumnIdPrefix + GridlyCulture);
+				CellJsonObject->SetStringField("columnId", Settings.SourceLanguageColumnIdPrefix + GridlyCulture);
 				CellJsonObject->SetStringField("value", NativeString);
 				CellsJsonArray.Add(MakeShareable(new FJsonValueObject(CellJsonObject)));
 			}
 
 			// Add context
 
-			if (ItemContext && GameSettings->bExportContext)
+			if (ItemContext && Settings.bExportContext)
 			{				
 				TSharedPtr<FJsonObject> CellJsonObject = MakeShareable(new FJsonObject);
-				CellJsonObject->SetStringField("columnId", *GameSettings->ContextColumnId);
+				CellJsonObject->SetStringField("columnId", *Settings.ContextColumnId);
 				CellJsonObject->SetStringField("value",
 					ItemContext->SourceLocation.Replace(TEXT(" - line "), TEXT(":"), ESearchCase::CaseSensitive));
 				CellsJsonArray.Add(MakeShareable(new FJsonValueObject(CellJsonObject)));
@@ -98,12 +99,12 @@ bool FGridlyExporter::ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTex
 
 			// Add metadata
 
- 			if (ItemContext && GameSettings->bExportMetadata && ItemContext->InfoMetadataObj.IsValid())
+ 			if (ItemContext && Settings.bExportMetadata && ItemContext->InfoMetadataObj.IsValid())
 			{
 				for (const auto& InfoMetaDataPair : ItemContext->InfoMetadataObj->Values)
 				{
 					const FString& KeyName = InfoMetaDataPair.Key;
-					if (const FGridlyColumnInfo* GridlyColumnInfo = GameSettings->MetadataMapping.Find(InfoMetaDataPair.Key))
+					if (const FGridlyColumnInfo* GridlyColumnInfo = Settings.MetadataMapping.Find(InfoMetaDataPair.Key))
 					{
 						TSharedPtr<FJsonObject> CellJsonObject = MakeShareable(new FJsonObject);
 						CellJsonObject->SetStringField("columnId", *GridlyColumnInfo->Name);
@@ -140,10 +141,10 @@ bool FGridlyExporter::ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTex
 
 					if (CultureName != NativeCulture
 					    && PolyglotTextDatas[i].GetLocalizedString(CultureName, LocalizedString)
-					    && FGridlyCultureConverter::ConvertToGridly(CultureName, GridlyCulture))
+					    && CultureConverter.ToGridly(CultureName, GridlyCulture))
 					{
 						TSharedPtr<FJsonObject> CellJsonObject = MakeShareable(new FJsonObject);
-						CellJsonObject->SetStringField("columnId", GameSettings->TargetLanguageColumnIdPrefix + GridlyCulture);
+						CellJsonObject->SetStringField("columnId", Settings.TargetLanguageColumnIdPrefix + GridlyCulture);
 						CellJsonObject->SetStringField("value", LocalizedString);
 						CellsJsonArray.Add(MakeShareable(new FJsonValueObject(CellJsonObject)));
 					}
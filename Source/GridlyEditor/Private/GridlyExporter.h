@@ -5,11 +5,12 @@
 #include "GridlyDataTable.h"
 
 class FLocTextHelper;
+struct FGridlySettingsSnapshot;
 
 class FGridlyExporter
 {
 public:
-	static bool ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTextDatas, bool bIncludeTargetTranslations,
-		const TSharedPtr<FLocTextHelper>& LocTextHelperPtr, FString& OutJsonString);
+	static bool ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTextDatas, const FGridlySettingsSnapshot& Settings,
+		bool bIncludeTargetTranslations, const TSharedPtr<FLocTextHelper>& LocTextHelperPtr, FString& OutJsonString);
 	static bool ConvertToJson(const UGridlyDataTable* GridlyDataTable, FString& OutJsonString, size_t StartIndex, size_t MaxSize);
 };
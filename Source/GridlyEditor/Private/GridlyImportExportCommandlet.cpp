@@ -1,7 +1,11 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GridlyImportExportCommandlet.h"
+#include "GridlyImportedPoFiles.h"
 #include "GridlyLocalizationServiceProvider.h"
+#include "GridlyLocalizedText.h"
+#include "GridlyLocResCompiler.h"
+#include "GridlyTask_DownloadLocalizedTexts.h"
 #include "Modules/ModuleManager.h"
 #include "ILocalizationServiceModule.h"
 #include "LocalizationModule.h"
@@ -9,6 +13,8 @@
 #include "LocalizationTargetTypes.h"
 #include "HttpModule.h"
 #include "HttpManager.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
 #include "LocalizationConfigurationScript.h"
 
 #include "UObject/UObjectGlobals.h"
@@ -20,6 +26,18 @@ DEFINE_LOG_CATEGORY_STATIC(LogGridlyImportExportCommandlet, Log, All);
 
 #define LOCTEXT_NAMESPACE "GridlyImportExportCommandlet"
 
+/**
+*	Pumps HTTP requests and the core ticker, which the Gridly tasks use to send requests that have been delayed by the pacer
+*/
+static void TickPendingRequests()
+{
+	const float DeltaTime = 0.1f;
+	FPlatformProcess::Sleep(DeltaTime);
+	FHttpModule::Get().GetHttpManager().Tick(-1.f);
+	FTSTicker::GetCoreTicker().Tick(DeltaTime);
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+}
+
 /**
 *	UGridlyImportExportCommandlet
 */
@@ -30,6 +48,8 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 	TMap<FString, FString> ParamVals;
 	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
 
+	bForceImport = Switches.Contains(TEXT("ForceImport"));
+
 	// Load localization module and its dependencies
 	FModuleManager::Get().LoadModule(TEXT("LocalizationDashboard"));
 
@@ -80,12 +100,17 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 	bool bDoExport = false;
 	GetBoolFromConfig(*SectionName, TEXT("bExportLoc"), bDoExport, ConfigPath);
 
-	if (!bDoImport && !bDoExport)
+	bool bDoCompile = false;
+	GetBoolFromConfig(*SectionName, TEXT("bCompileLoc"), bDoCompile, ConfigPath);
+
+	if (!bDoImport && !bDoExport && !bDoCompile)
 	{
-		UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("Import/Export operation not detected.  Use bExportLoc or bImportLoc in config section."));
+		UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("Import/Export operation not detected.  Use bExportLoc, bImportLoc or bCompileLoc in config section."));
 		return -1;
 	}
 
+	int32 ReturnCode = 0;
+
 	const TArray<ULocalizationTarget*> LocalizationTargets = ULocalizationSettings::GetGameTargetSet()->TargetObjects;
 	//ULocalizationTarget* FirstLocTarget = LocalizationTargets.Num() > 0 ? LocalizationTargets[0]: nullptr;
 	for (ULocalizationTarget* LocTarget : LocalizationTargets)
@@ -93,6 +118,10 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 		// Do something with LocTarget
 		if (LocTarget != nullptr)
 		{
+			// With bImportLoc, the .locres files are compiled from the texts the import downloads
+			bool bCompiled = false;
+			bool bCompileSucceeded = false;
+
 			if (bDoImport)
 			{
 				// List all cultures (even the native one in case some native translations have been modified in Gridly) to download
@@ -108,9 +137,9 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 
 				// Download cultures from Gridly
 				CulturesToDownload.Append(Cultures);
+				TArray<TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>> DownloadOperations;
 				for (const FString& CultureName : Cultures)
 				{
-					ILocalizationServiceProvider& Provider = ILocalizationServiceModule::Get().GetProvider();
 					TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe> DownloadTargetFileOp =
 						ILocalizationServiceOperation::Create<FDownloadLocalizationTargetFile>();
 					DownloadTargetFileOp->SetInTargetGuid(LocTarget->Settings.Guid);
@@ -122,22 +151,76 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 					FString NormalizedPath = FPaths::ConvertRelativePathToFull(Path);
 					DownloadTargetFileOp->SetInRelativeOutputFilePathAndName(Path);
 
-					auto OperationCompleteDelegate = FLocalizationServiceOperationComplete::CreateUObject(this,
-						&UGridlyImportExportCommandlet::OnDownloadComplete, false);
+					DownloadOperations.Add(DownloadTargetFileOp);
+				}
+
+				// Download the views once for all cultures
+				auto OperationCompleteDelegate = FLocalizationServiceOperationComplete::CreateUObject(this,
+					&UGridlyImportExportCommandlet::OnDownloadComplete, false);
+
+				// With bImportDirectlyToArchives the archives are updated in this process, without .po files or import commandlet
+				bool bImportedToArchives = false;
+				TArray<FString> ChangedArchiveCultures;
+				FGridlyLocalizationServiceProvider::FImportDownloadedTexts ImportTexts;
+				if (GetDefault<UGridlyGameSettings>()->bImportDirectlyToArchives)
+				{
+					ImportTexts = [this, LocTarget, Cultures, &bImportedToArchives, &ChangedArchiveCultures](
+						const TArray<FPolyglotTextData>& PolyglotTextDatas, FText& OutError)
+					{
+						bImportedToArchives = FGridlyLocalizedText::ImportPolyglotTextDatasToArchives(LocTarget, PolyglotTextDatas,
+							Cultures, ChangedArchiveCultures, OutError, bForceImport);
+						return bImportedToArchives;
+					};
+				}
 
-					Provider.Execute(DownloadTargetFileOp, TArray<FLocalizationServiceTranslationIdentifier>(),
-						ELocalizationServiceOperationConcurrency::Synchronous, OperationCompleteDelegate);
+				FGridlyLocalizationServiceProvider::FOnTextsDownloaded OnTextsDownloaded;
+				if (bDoCompile)
+				{
+					OnTextsDownloaded = [LocTarget, &bCompiled, &bCompileSucceeded](const TArray<FPolyglotTextData>& PolyglotTextDatas)
+					{
+						FText Error;
+						bCompileSucceeded = FGridlyLocResCompiler::CompileTarget(LocTarget, PolyglotTextDatas, Error);
+						if (!bCompileSucceeded)
+						{
+							UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("%s"), *Error.ToString());
+						}
+						bCompiled = true;
+					};
 				}
 
+				GridlyProvider->ExecuteDownloads(DownloadOperations, OperationCompleteDelegate, ImportTexts, OnTextsDownloaded);
+
 				// Wait for all downloads
 				while (CulturesToDownload.Num())
 				{
-					FPlatformProcess::Sleep(0.4f);
-					FHttpModule::Get().GetHttpManager().Tick(-1.f);
+					TickPendingRequests();
 				}
 
+				if (ImportTexts)
+				{
+					// Only the reports are left to update, and only if an archive has changed
+					if (bImportedToArchives && ChangedArchiveCultures.Num() > 0)
+					{
+						FString ReportScriptPath = LocalizationConfigurationScript::GetWordCountReportConfigPath(LocTarget);
+						ReportScriptPath = FConfigCacheIni::NormalizeConfigIniPath(ReportScriptPath);
+						LocalizationConfigurationScript::GenerateWordCountReportConfigFile(LocTarget).WriteWithSCC(ReportScriptPath);
+						BlockingRunLocCommandletTask({ LocalizationCommandletExecution::FTask(LOCTEXT("ReportTaskName", "Generate Reports"),
+							ReportScriptPath, !LocTarget->IsMemberOfEngineTargetSet()) });
+					}
+					else if (bImportedToArchives)
+					{
+						UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("No culture has changed on Gridly since the last import, skipping the import of %s."),
+							*LocTarget->Settings.Name);
+					}
+				}
+				else if (DownloadedFiles.Num() > 0 && ChangedCulturePoFiles.Num() == 0)
+				{
+					// Spawning the commandlets is the slowest part of the import, so they are skipped when there is nothing new
+					UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("No culture has changed on Gridly since the last import, skipping the import of %s."),
+						*LocTarget->Settings.Name);
+				}
 				// Run task to import po files, it will be done on the base folder and import all po files data generated after downloading data from gridly
-				if (CulturesToDownload.Num() == 0 && DownloadedFiles.Num() > 0)
+				else if (CulturesToDownload.Num() == 0 && DownloadedFiles.Num() > 0)
 				{
 					const FString& DlPoFile = DownloadedFiles[0]; // retrieve first po file to deduce the base folder
 					const FString TargetName = FPaths::GetBaseFilename(DlPoFile);
@@ -152,11 +235,26 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 					TArray<LocalizationCommandletExecution::FTask> Tasks;
 					const bool ShouldUseProjectFile = !Target->IsMemberOfEngineTargetSet();
 
-					// Normalize Import config path
-					FString ImportScriptPath = LocalizationConfigurationScript::GetImportTextConfigPath(Target, TOptional<FString>());
-					ImportScriptPath = FConfigCacheIni::NormalizeConfigIniPath(ImportScriptPath);
-					LocalizationConfigurationScript::GenerateImportTextConfigFile(Target, TOptional<FString>(), DownloadBasePath).WriteWithSCC(ImportScriptPath);
-					Tasks.Add(LocalizationCommandletExecution::FTask(LOCTEXT("ImportTaskName", "Import Translations"), ImportScriptPath, ShouldUseProjectFile));
+					// Every task spawns a commandlet, so a single culture is imported on its own and anything more in one go
+					if (ChangedCulturePoFiles.Num() > 1)
+					{
+						// Normalize Import config path
+						FString ImportScriptPath = LocalizationConfigurationScript::GetImportTextConfigPath(Target, TOptional<FString>());
+						ImportScriptPath = FConfigCacheIni::NormalizeConfigIniPath(ImportScriptPath);
+						LocalizationConfigurationScript::GenerateImportTextConfigFile(Target, TOptional<FString>(), DownloadBasePath).WriteWithSCC(ImportScriptPath);
+						Tasks.Add(LocalizationCommandletExecution::FTask(LOCTEXT("ImportTaskName", "Import Translations"), ImportScriptPath, ShouldUseProjectFile));
+					}
+					else
+					{
+						for (const TPair<FString, FString>& Pair : ChangedCulturePoFiles)
+						{
+							FString ImportScriptPath = LocalizationConfigurationScript::GetImportTextConfigPath(Target, Pair.Key);
+							ImportScriptPath = FConfigCacheIni::NormalizeConfigIniPath(ImportScriptPath);
+							LocalizationConfigurationScript::GenerateImportTextConfigFile(Target, Pair.Key, Pair.Value).WriteWithSCC(ImportScriptPath);
+							Tasks.Add(LocalizationCommandletExecution::FTask(FText::Format(LOCTEXT("ImportCultureTaskName", "Import Translations ({0})"),
+								FText::FromString(Pair.Key)), ImportScriptPath, ShouldUseProjectFile));
+						}
+					}
 
 					// Normalize Report config path
 					FString ReportScriptPath = LocalizationConfigurationScript::GetWordCountReportConfigPath(Target);
@@ -166,12 +264,59 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 
 
 					// Function will block until all tasks have been run
-					BlockingRunLocCommandletTask(Tasks);
+					if (BlockingRunLocCommandletTask(Tasks))
+					{
+						// Importing the whole target imports the unchanged cultures again too
+						TArray<FString> PoFilePaths;
+						(ChangedCulturePoFiles.Num() > 1 ? DownloadedCulturePoFiles : ChangedCulturePoFiles).GenerateValueArray(PoFilePaths);
+						FGridlyImportedPoFiles::MarkImported(PoFilePaths);
+					}
 				}
 
 				// Cleanup
 				CulturesToDownload.Empty();
 				DownloadedFiles.Empty();
+				ChangedCulturePoFiles.Empty();
+				DownloadedCulturePoFiles.Empty();
+			}
+
+			if (bDoCompile && !bDoImport)
+			{
+				// Compiles the .locres files straight from Gridly, without the gather/import/compile commandlets
+				UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("Compiling %s from Gridly."), *LocTarget->Settings.Name);
+
+				UGridlyTask_DownloadLocalizedTexts* Task = UGridlyTask_DownloadLocalizedTexts::DownloadLocalizedTextsPooled(nullptr);
+
+				Task->OnSuccessDelegate.BindLambda([LocTarget, &bCompiled, &bCompileSucceeded](const TArray<FPolyglotTextData>& PolyglotTextDatas)
+				{
+					FText Error;
+					bCompileSucceeded = FGridlyLocResCompiler::CompileTarget(LocTarget, PolyglotTextDatas, Error);
+					if (!bCompileSucceeded)
+					{
+						UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("%s"), *Error.ToString());
+					}
+					bCompiled = true;
+				});
+
+				Task->OnFailDelegate.BindLambda([&bCompiled](const TArray<FPolyglotTextData>& PolyglotTextDatas, const FGridlyResult& Error)
+				{
+					UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("%s"), *Error.Message);
+					bCompiled = true;
+				});
+
+				Task->Activate();
+
+				while (!bCompiled)
+				{
+					TickPendingRequests();
+				}
+			}
+
+			// A failed download never reaches the compiler, so it fails the compile too
+			if (bDoCompile && !bCompileSucceeded)
+			{
+				UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("Failed to compile %s from Gridly."), *LocTarget->Settings.Name);
+				ReturnCode = -1;
 			}
 
 			if (bDoExport)
@@ -202,8 +347,7 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 				// Wait for export requests to complete
 				while (GridlyProvider->HasRequestsPending())
 				{
-					FPlatformProcess::Sleep(0.4f);
-					FHttpModule::Get().GetHttpManager().Tick(-1.f);
+					TickPendingRequests();
 				}
 
 				const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
@@ -216,8 +360,7 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 					// Wait for delete requests to finish
 					while (GridlyProvider->HasDeleteRequestsPending())
 					{
-						FPlatformProcess::Sleep(0.4f);
-						FHttpModule::Get().GetHttpManager().Tick(-1.f);
+						TickPendingRequests();
 					}
 					UE_LOG(LogGridlyImportExportCommandlet, Warning, TEXT("All record deletions completed."));
 
@@ -231,7 +374,7 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 			break;
 		}
 	}
-	return 0;
+	return ReturnCode;
 }
 
 void UGridlyImportExportCommandlet::OnDownloadComplete(const FLocalizationServiceOperationRef& Operation, ELocalizationServiceOperationCommandResult::Type Result, bool bIsTargetSet)
@@ -240,23 +383,33 @@ void UGridlyImportExportCommandlet::OnDownloadComplete(const FLocalizationServic
 	TSharedPtr<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe> DownloadLocalizationTargetOp = StaticCastSharedRef<FDownloadLocalizationTargetFile>(Operation);
 	CulturesToDownload.Remove(DownloadLocalizationTargetOp->GetInLocale());
 
+	const FString AbsoluteFilePathAndName = FPaths::ConvertRelativePathToFull(
+		FPaths::ProjectDir() / DownloadLocalizationTargetOp->GetInRelativeOutputFilePathAndName());
+
 	if (Result != ELocalizationServiceOperationCommandResult::Succeeded)
 	{
 		const FText ErrorMessage = DownloadLocalizationTargetOp->GetOutErrorText();
 		UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("%s"), *ErrorMessage.ToString());
 	}
-
-	const FString TargetName = FPaths::GetBaseFilename(DownloadLocalizationTargetOp->GetInRelativeOutputFilePathAndName());
-
-	const auto Target = ILocalizationModule::Get().GetLocalizationTargetByName(TargetName, false);
-	const FString AbsoluteFilePathAndName = FPaths::ConvertRelativePathToFull(
-		FPaths::ProjectDir() / DownloadLocalizationTargetOp->GetInRelativeOutputFilePathAndName());
+	else if (bForceImport || FGridlyImportedPoFiles::HasChanged(AbsoluteFilePathAndName))
+	{
+		DownloadedCulturePoFiles.Add(DownloadLocalizationTargetOp->GetInLocale(), AbsoluteFilePathAndName);
+		ChangedCulturePoFiles.Add(DownloadLocalizationTargetOp->GetInLocale(), AbsoluteFilePathAndName);
+	}
+	else
+	{
+		DownloadedCulturePoFiles.Add(DownloadLocalizationTargetOp->GetInLocale(), AbsoluteFilePathAndName);
+		UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("%s hasn't changed since it was last imported, skipping it."),
+			*DownloadLocalizationTargetOp->GetInLocale());
+	}
 
 	DownloadedFiles.Add(AbsoluteFilePathAndName);
 }
 
-void UGridlyImportExportCommandlet::BlockingRunLocCommandletTask(const TArray<LocalizationCommandletExecution::FTask>& Tasks)
+bool UGridlyImportExportCommandlet::BlockingRunLocCommandletTask(const TArray<LocalizationCommandletExecution::FTask>& Tasks)
 {
+	bool bSucceeded = true;
+
 	for (const LocalizationCommandletExecution::FTask& LocTask : Tasks)
 	{
 		TSharedPtr<FLocalizationCommandletProcess> CommandletProcess = FLocalizationCommandletProcess::Execute(LocTask.ScriptPath, LocTask.ShouldUseProjectFile);
@@ -294,12 +447,17 @@ void UGridlyImportExportCommandlet::BlockingRunLocCommandletTask(const TArray<Lo
 			{
 				UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("===> Task [%s] returned : %d"), *LocTask.Name.ToString(), ReturnCode);
 			}
+
+			bSucceeded &= ReturnCode == 0;
 		}
 		else
 		{
 			UE_LOG(LogGridlyImportExportCommandlet, Warning, TEXT("Failed to start Task [%s] !"), *LocTask.Name.ToString());
+			bSucceeded = false;
 		}
 	}
+
+	return bSucceeded;
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -30,7 +30,17 @@ private:
 	TArray<FString> CulturesToDownload;
 	TArray<FString> DownloadedFiles;
 
+	// Culture -> downloaded .po file, for the cultures whose file changed since it was last imported
+	TMap<FString, FString> ChangedCulturePoFiles;
+
+	// Culture -> downloaded .po file, for every culture downloaded successfully
+	TMap<FString, FString> DownloadedCulturePoFiles;
+
+	// Set by -ForceImport, imports every culture even if its .po file or translations haven't changed
+	bool bForceImport = false;
+
 private:
 	void OnDownloadComplete(const FLocalizationServiceOperationRef& Operation, ELocalizationServiceOperationCommandResult::Type Result, bool bIsTargetSet);
-	void BlockingRunLocCommandletTask(const TArray<LocalizationCommandletExecution::FTask>& LocTasks);
+	/** Returns true if every task ran and returned 0 */
+	bool BlockingRunLocCommandletTask(const TArray<LocalizationCommandletExecution::FTask>& LocTasks);
 };
\ No newline at end of file
@@ -0,0 +1,95 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyImportedPoFiles.h"
+
+#include "GridlyEditor.h"
+#include "LocalizationConfigurationScript.h"
+#include "LocalizationModule.h"
+#include "LocalizationTargetTypes.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+bool FGridlyImportedPoFiles::HasChanged(const FString& PoFilePath)
+{
+	const FString Hash = HashImportState(PoFilePath);
+	if (Hash.IsEmpty())
+	{
+		return true;
+	}
+
+	FString ImportedHash;
+	const TSharedPtr<FJsonObject> Hashes = LoadHashes();
+	return !Hashes->TryGetStringField(FPaths::ConvertRelativePathToFull(PoFilePath), ImportedHash) || ImportedHash != Hash;
+}
+
+void FGridlyImportedPoFiles::MarkImported(const TArray<FString>& PoFilePaths)
+{
+	const TSharedPtr<FJsonObject> Hashes = LoadHashes();
+
+	for (const FString& PoFilePath : PoFilePaths)
+	{
+		const FString Hash = HashImportState(PoFilePath);
+		if (!Hash.IsEmpty())
+		{
+			Hashes->SetStringField(FPaths::ConvertRelativePathToFull(PoFilePath), Hash);
+		}
+	}
+
+	FString JsonString;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonString);
+	if (!FJsonSerializer::Serialize(Hashes.ToSharedRef(), JsonWriter) || !FFileHelper::SaveStringToFile(JsonString, *GetHashesPath()))
+	{
+		UE_LOG(LogGridlyEditor, Warning, TEXT("Failed to save imported .po file hashes to %s"), *GetHashesPath());
+	}
+}
+
+FString FGridlyImportedPoFiles::GetHashesPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Gridly") / TEXT("ImportedPoFiles.json");
+}
+
+FString FGridlyImportedPoFiles::HashFile(const FString& FilePath)
+{
+	const FMD5Hash Hash = FMD5Hash::HashFile(*FilePath);
+	return Hash.IsValid() ? LexToString(Hash) : FString();
+}
+
+FString FGridlyImportedPoFiles::HashImportState(const FString& PoFilePath)
+{
+	FString Hash = HashFile(PoFilePath);
+	if (Hash.IsEmpty())
+	{
+		return Hash;
+	}
+
+	const FString TargetName = FPaths::GetBaseFilename(PoFilePath);
+	const FString Culture = FPaths::GetCleanFilename(FPaths::GetPath(PoFilePath));
+
+	// A missing manifest or archive hashes to an empty string, which still differs from one that exists
+	if (const ULocalizationTarget* Target = ILocalizationModule::Get().GetLocalizationTargetByName(TargetName, false))
+	{
+		Hash += TEXT("|") + HashFile(LocalizationConfigurationScript::GetManifestPath(Target));
+		Hash += TEXT("|") + HashFile(LocalizationConfigurationScript::GetArchivePath(Target, Culture));
+	}
+
+	return Hash;
+}
+
+TSharedPtr<FJsonObject> FGridlyImportedPoFiles::LoadHashes()
+{
+	FString JsonString;
+	TSharedPtr<FJsonObject> Hashes;
+
+	if (FFileHelper::LoadFileToString(JsonString, *GetHashesPath()))
+	{
+		const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+		FJsonSerializer::Deserialize(JsonReader, Hashes);
+	}
+
+	return Hashes.IsValid() ? Hashes : MakeShareable(new FJsonObject);
+}
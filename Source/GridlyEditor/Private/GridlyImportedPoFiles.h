@@ -0,0 +1,32 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * Remembers the content hash of the .po files downloaded from Gridly when they were last imported, so a culture whose file
+ * hasn't changed since can skip the import commandlet.
+ * The manifest and the archive of the culture are hashed with the file, so a re-gather or a reverted archive imports it
+ * again. They are found from the path of the file, {Base}/{Culture}/{Target}.po, the layout the import commandlet reads.
+ * The hashes are stored in Saved/Gridly/ImportedPoFiles.json
+ */
+class FGridlyImportedPoFiles
+{
+public:
+	/** True if the file, the manifest or the archive differ from when it was last imported, or it has never been imported */
+	static bool HasChanged(const FString& PoFilePath);
+
+	/** Records the current content of the files and their archives as imported. Call once the import commandlet has succeeded */
+	static void MarkImported(const TArray<FString>& PoFilePaths);
+
+private:
+	static FString GetHashesPath();
+	static FString HashFile(const FString& FilePath);
+
+	/** The hashes of the .po file, the manifest and the archive it is imported to. Empty if the .po file can't be read */
+	static FString HashImportState(const FString& PoFilePath);
+	static TSharedPtr<FJsonObject> LoadHashes();
+};
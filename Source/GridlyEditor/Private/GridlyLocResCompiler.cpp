@@ -0,0 +1,131 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyLocResCompiler.h"
+
+#include "GridlyEditor.h"
+#include "GridlyLocalizedText.h"
+#include "LocalizationConfigurationScript.h"
+#include "LocalizationTargetTypes.h"
+#include "LocTextHelper.h"
+#include "Internationalization/PolyglotTextData.h"
+#include "Internationalization/TextLocalizationResource.h"
+#include "Misc/Paths.h"
+
+#define LOCTEXT_NAMESPACE "GridlyLocResCompiler"
+
+bool FGridlyLocResCompiler::CompileTarget(ULocalizationTarget* LocalizationTarget,
+	const TArray<FPolyglotTextData>& PolyglotTextDatas, FText& OutError)
+{
+	const FLocalizationTargetSettings& Settings = LocalizationTarget->Settings;
+	if (!Settings.SupportedCulturesStatistics.IsValidIndex(Settings.NativeCultureIndex))
+	{
+		OutError = FText::Format(LOCTEXT("NoNativeCulture", "No native culture found for target {0}"), FText::FromString(Settings.Name));
+		return false;
+	}
+
+	const FString DataDirectory = FPaths::ConvertRelativePathToFull(LocalizationConfigurationScript::GetDataDirectory(LocalizationTarget));
+	const FString LocResFilename = Settings.Name + TEXT(".locres");
+
+	FTextLocalizationMetaDataResource LocMeta;
+	LocMeta.NativeCulture = Settings.SupportedCulturesStatistics[Settings.NativeCultureIndex].CultureName;
+	LocMeta.NativeLocRes = LocMeta.NativeCulture / LocResFilename;
+
+	TArray<FString> ForeignCultures;
+	for (const FCultureStatistics& CultureStatistics : Settings.SupportedCulturesStatistics)
+	{
+		if (CultureStatistics.CultureName != LocMeta.NativeCulture)
+		{
+			ForeignCultures.Add(CultureStatistics.CultureName);
+		}
+	}
+
+	// The manifest decides which texts belong to the target, the views may hold the texts of other targets too
+	TSharedPtr<FLocTextHelper> LocTextHelper;
+	if (!FGridlyLocalizedText::LoadLocTextHelper(LocalizationTarget, ForeignCultures, LocTextHelper, OutError))
+	{
+		return false;
+	}
+
+	const FGridlyLocalizedText::FTextsByGridlyKey GridlyTexts = FGridlyLocalizedText::MapTextsByGridlyKey(PolyglotTextDatas);
+
+	for (const FCultureStatistics& CultureStatistics : Settings.SupportedCulturesStatistics)
+	{
+		const FString& Culture = CultureStatistics.CultureName;
+		if (!CompileCulture(*LocTextHelper, GridlyTexts, Culture, DataDirectory / Culture / LocResFilename, OutError))
+		{
+			return false;
+		}
+
+		LocMeta.CompiledCultures.Add(Culture);
+	}
+
+	const FString LocMetaPath = DataDirectory / Settings.Name + TEXT(".locmeta");
+	if (!LocMeta.SaveToFile(LocMetaPath))
+	{
+		OutError = FText::Format(LOCTEXT("SaveLocMetaFailed", "Failed to save {0}"), FText::FromString(LocMetaPath));
+		return false;
+	}
+
+	UE_LOG(LogGridlyEditor, Log, TEXT("Compiled %d cultures of %s from Gridly"), LocMeta.CompiledCultures.Num(), *Settings.Name);
+	return true;
+}
+
+bool FGridlyLocResCompiler::CompileCulture(const FLocTextHelper& LocTextHelper,
+	const FGridlyLocalizedText::FTextsByGridlyKey& GridlyTexts, const FString& Culture, const FString& LocResPath, FText& OutError)
+{
+	const FTextKey LocResId(LocResPath);
+	FTextLocalizationResource LocRes;
+	FString LocalizedString;
+	int32 NumFromGridly = 0;
+	int32 NumFromArchive = 0;
+
+	LocTextHelper.EnumerateSourceTexts([&](TSharedRef<FManifestEntry> ManifestEntry)
+	{
+		for (const FManifestContext& Context : ManifestEntry->Contexts)
+		{
+			const FLocKey GridlyNamespace(FGridlyLocalizedText::GetGridlyNamespace(*ManifestEntry, Context));
+			const FPolyglotTextData* const* GridlyText = GridlyTexts.Find(MakeTuple(GridlyNamespace, Context.Key));
+
+			LocalizedString.Reset();
+			if (GridlyText && (*GridlyText)->GetLocalizedString(Culture, LocalizedString) && !LocalizedString.IsEmpty())
+			{
+				NumFromGridly++;
+			}
+			else
+			{
+				// Same as the compile commandlet: the archive translation, or the native text if there is none
+				FLocItem RuntimeText;
+				if (!LocTextHelper.GetRuntimeText(Culture, ManifestEntry->Namespace, Context.Key, Context.KeyMetadataObj,
+					ELocTextExportSourceMethod::NativeText, ManifestEntry->Source, RuntimeText, false))
+				{
+					continue;
+				}
+
+				LocalizedString = RuntimeText.Text;
+				NumFromArchive++;
+			}
+
+			if (LocalizedString.IsEmpty())
+			{
+				continue;
+			}
+
+			// The source string is hashed into the entry, so the runtime can tell when the translation is out of date
+			LocRes.AddEntry(FTextKey(ManifestEntry->Namespace.GetString()), FTextKey(Context.Key.GetString()), ManifestEntry->Source.Text,
+				LocalizedString, 0, LocResId);
+		}
+		return true;
+	}, true);
+
+	if (!LocRes.SaveToFile(LocResPath))
+	{
+		OutError = FText::Format(LOCTEXT("SaveLocResFailed", "Failed to save {0}"), FText::FromString(LocResPath));
+		return false;
+	}
+
+	UE_LOG(LogGridlyEditor, Log, TEXT("Compiled %s, %d translations from Gridly and %d from the archive"), *LocResPath, NumFromGridly,
+		NumFromArchive);
+	return true;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,30 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridlyLocalizedText.h"
+#include "Internationalization/PolyglotTextData.h"
+
+class FLocTextHelper;
+class ULocalizationTarget;
+
+/**
+ * Compiles downloaded texts straight to the .locres files of a localization target and to its .locmeta, the files the
+ * compile step of the localization dashboard writes. The gather/import/compile commandlets are skipped, so a fix made on
+ * Gridly can be tested without running them
+ */
+class FGridlyLocResCompiler
+{
+public:
+	/**
+	 * Compiles every culture of the target into Content/Localization/{Target}. Only the texts in the manifest of the target
+	 * are compiled, and the texts Gridly has no translation for keep the one in their archive
+	 */
+	static bool CompileTarget(ULocalizationTarget* LocalizationTarget, const TArray<FPolyglotTextData>& PolyglotTextDatas,
+		FText& OutError);
+
+private:
+	static bool CompileCulture(const FLocTextHelper& LocTextHelper, const FGridlyLocalizedText::FTextsByGridlyKey& GridlyTexts,
+		const FString& Culture, const FString& LocResPath, FText& OutError);
+};
@@ -4,9 +4,12 @@
 
 #include "GridlyEditor.h"
 #include "GridlyExporter.h"
+#include "GridlyImportedPoFiles.h"
+#include "GridlyLocResCompiler.h"
 #include "GridlyGameSettings.h"
 #include "GridlyLocalizedText.h"
 #include "GridlyLocalizedTextConverter.h"
+#include "GridlySettingsSnapshot.h"
 #include "GridlyStyle.h"
 #include "GridlyTask_DownloadLocalizedTexts.h"
 #include "HttpModule.h"
@@ -81,6 +84,7 @@ public:
 	TSharedPtr<FUICommandInfo> ExportNativeCultureForTargetToGridly;
 	TSharedPtr<FUICommandInfo> ExportTranslationsForTargetToGridly;
 	TSharedPtr<FUICommandInfo> DownloadSourceChangesFromGridly;
+	TSharedPtr<FUICommandInfo> CompileLocResForTargetFromGridly;
 
 	/** Initialize commands */
 	virtual void RegisterCommands() override;
@@ -97,6 +101,9 @@ void FGridlyLocalizationTargetEditorCommands::RegisterCommands()
 		"Exports source text and all translations of this target to Gridly.", EUserInterfaceActionType::Button, FInputChord());
 	UI_COMMAND(DownloadSourceChangesFromGridly, "Download Source Changes",
 		"Downloads source changes from Gridly and updates string tables with CSV import.", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(CompileLocResForTargetFromGridly, "Compile from Gridly",
+		"Compiles the translations on Gridly straight to the .locres files of this target, without importing them to the archives.",
+		EUserInterfaceActionType::Button, FInputChord());
 }
 
 FGridlyLocalizationServiceProvider::FGridlyLocalizationServiceProvider()
@@ -158,65 +165,155 @@ ELocalizationServiceOperationCommandResult::Type FGridlyLocalizationServiceProvi
 {
 	const TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe> DownloadOperation =
 		StaticCastSharedRef<FDownloadLocalizationTargetFile>(InOperation);
-	const FString TargetCulture = DownloadOperation->GetInLocale();
 
-	UGridlyTask_DownloadLocalizedTexts* Task = UGridlyTask_DownloadLocalizedTexts::DownloadLocalizedTexts(nullptr);
+	ExecuteDownloads({ DownloadOperation }, InOperationCompleteDelegate);
+
+	return ELocalizationServiceOperationCommandResult::Succeeded;
+}
+
+void FGridlyLocalizationServiceProvider::ExecuteDownloads(
+	const TArray<TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>>& DownloadOperations,
+	const FLocalizationServiceOperationComplete& InOperationCompleteDelegate, const FImportDownloadedTexts& ImportTexts,
+	const FOnTextsDownloaded& OnTextsDownloaded)
+{
+	if (DownloadOperations.Num() == 0)
+	{
+		return;
+	}
+
+	// The view is downloaded and converted once, then every requested culture is written from the same result
+
+	UGridlyTask_DownloadLocalizedTexts* Task = UGridlyTask_DownloadLocalizedTexts::DownloadLocalizedTextsPooled(nullptr);
+
+	for (const TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>& DownloadOperation : DownloadOperations)
+	{
+		ActiveDownloadTasks.Add(&DownloadOperation.Get(), Task);
+	}
 
 	// On success
 	Task->OnSuccessDelegate.BindLambda(
-		[this, DownloadOperation, InOperationCompleteDelegate, TargetCulture](const TArray<FPolyglotTextData>& PolyglotTextDatas)
+		[this, DownloadOperations, InOperationCompleteDelegate, ImportTexts, OnTextsDownloaded](const TArray<FPolyglotTextData>& PolyglotTextDatas)
 		{
-			/*
-			if (PolyglotTextDatas.Num() > 0)
+			RemoveActiveDownloads(DownloadOperations);
+
+			if (OnTextsDownloaded)
 			{
-			*/
-			const FString AbsoluteFilePathAndName = FPaths::ConvertRelativePathToFull(
-				FPaths::ProjectDir() / DownloadOperation->GetInRelativeOutputFilePathAndName());
-
-			bool writeProc = FGridlyLocalizedTextConverter::WritePoFile(PolyglotTextDatas, TargetCulture, AbsoluteFilePathAndName);
-			// Callback for successful write
-			InOperationCompleteDelegate.Execute(DownloadOperation, ELocalizationServiceOperationCommandResult::Succeeded);
-			/*
+				OnTextsDownloaded(PolyglotTextDatas);
 			}
-			else
+
+			if (ImportTexts)
+			{
+				FText ImportError;
+				const ELocalizationServiceOperationCommandResult::Type Result = ImportTexts(PolyglotTextDatas, ImportError)
+					? ELocalizationServiceOperationCommandResult::Succeeded
+					: ELocalizationServiceOperationCommandResult::Failed;
+
+				for (const TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>& DownloadOperation : DownloadOperations)
+				{
+					DownloadOperation->SetOutErrorText(ImportError);
+					InOperationCompleteDelegate.ExecuteIfBound(DownloadOperation, Result);
+				}
+				return;
+			}
+
+			// All cultures are written in one pass over the texts
+			TArray<TPair<FString, FString>> CulturePaths;
+			for (const TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>& DownloadOperation : DownloadOperations)
 			{
-				// Handle parse failure
-				DownloadOperation->SetOutErrorText(LOCTEXT("GridlyErrorParse", "Failed to parse downloaded content"));
-				InOperationCompleteDelegate.Execute(DownloadOperation, ELocalizationServiceOperationCommandResult::Failed);
+				const FString AbsoluteFilePathAndName = FPaths::ConvertRelativePathToFull(
+					FPaths::ProjectDir() / DownloadOperation->GetInRelativeOutputFilePathAndName());
+				CulturePaths.Emplace(DownloadOperation->GetInLocale(), AbsoluteFilePathAndName);
+			}
+
+			FGridlyLocalizedTextConverter::WritePoFiles(PolyglotTextDatas, CulturePaths);
+
+			for (const TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>& DownloadOperation : DownloadOperations)
+			{
+				// Callback for successful write
+				InOperationCompleteDelegate.ExecuteIfBound(DownloadOperation, ELocalizationServiceOperationCommandResult::Succeeded);
 			}
-			*/
 		});
 
 	// On fail
 	Task->OnFailDelegate.BindLambda(
-		[DownloadOperation, InOperationCompleteDelegate](const TArray<FPolyglotTextData>& PolyglotTextDatas, const FGridlyResult& Error)
+		[this, DownloadOperations, InOperationCompleteDelegate](const TArray<FPolyglotTextData>& PolyglotTextDatas, const FGridlyResult& Error)
 		{
+			RemoveActiveDownloads(DownloadOperations);
+
 			// Handle download failure
-			DownloadOperation->SetOutErrorText(FText::FromString(Error.Message));
-			InOperationCompleteDelegate.Execute(DownloadOperation, ELocalizationServiceOperationCommandResult::Failed);
+			const ELocalizationServiceOperationCommandResult::Type Result = Error.bCancelled
+				? ELocalizationServiceOperationCommandResult::Cancelled
+				: ELocalizationServiceOperationCommandResult::Failed;
+
+			for (const TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>& DownloadOperation : DownloadOperations)
+			{
+				DownloadOperation->SetOutErrorText(FText::FromString(Error.Message));
+				InOperationCompleteDelegate.ExecuteIfBound(DownloadOperation, Result);
+			}
 		});
 
 	// Activate the task
 	Task->Activate();
-
-	return ELocalizationServiceOperationCommandResult::Succeeded;
 }
 
 
 
+void FGridlyLocalizationServiceProvider::RemoveActiveDownloads(
+	const TArray<TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>>& DownloadOperations)
+{
+	for (const TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>& DownloadOperation : DownloadOperations)
+	{
+		ActiveDownloadTasks.Remove(&DownloadOperation.Get());
+	}
+}
+
 bool FGridlyLocalizationServiceProvider::CanCancelOperation(
 	const TSharedRef<ILocalizationServiceOperation, ESPMode::ThreadSafe>& InOperation) const
 {
-	return false;
+	return ActiveDownloadTasks.Contains(&InOperation.Get());
 }
 
 void FGridlyLocalizationServiceProvider::CancelOperation(
 	const TSharedRef<ILocalizationServiceOperation, ESPMode::ThreadSafe>& InOperation)
 {
+	// Operations batched by ExecuteDownloads share one download, so they are all cancelled together
+	const TWeakObjectPtr<UGridlyTask_DownloadLocalizedTexts>* Task = ActiveDownloadTasks.Find(&InOperation.Get());
+	if (Task && Task->IsValid())
+	{
+		(*Task)->Cancel();
+	}
+}
+
+void FGridlyLocalizationServiceProvider::CancelDownloads()
+{
+	// The tasks report back through their fail delegates, which remove them from the map
+	TArray<TWeakObjectPtr<UGridlyTask_DownloadLocalizedTexts>> Tasks;
+	ActiveDownloadTasks.GenerateValueArray(Tasks);
+
+	for (const TWeakObjectPtr<UGridlyTask_DownloadLocalizedTexts>& Task : Tasks)
+	{
+		if (Task.IsValid())
+		{
+			Task->Cancel();
+		}
+	}
+	ActiveDownloadTasks.Empty();
 }
 
 void FGridlyLocalizationServiceProvider::Tick()
 {
+	// The slow task dialogs stay open while requests are in flight, so their cancel buttons are polled here
+
+	if (ImportAllCulturesForTargetFromGridlySlowTask.IsValid() && ImportAllCulturesForTargetFromGridlySlowTask->ShouldCancel())
+	{
+		CancelDownloads();
+		ImportAllCulturesForTargetFromGridlySlowTask.Reset();
+	}
+
+	if (ExportForTargetToGridlySlowTask.IsValid() && ExportForTargetToGridlySlowTask->ShouldCancel())
+	{
+		CancelExport();
+	}
 }
 
 #if LOCALIZATION_SERVICES_WITH_SLATE
@@ -289,6 +386,14 @@ void FGridlyLocalizationServiceProvider::AddTargetToolbarButtons(FToolBarBuilder
 			FGridlyLocalizationTargetEditorCommands::Get().DownloadSourceChangesFromGridly, NAME_None,
 			TAttribute<FText>(), TAttribute<FText>(), FSlateIcon(FGridlyStyle::GetStyleSetName(),
 				"Gridly.ImportAction"));
+
+		CommandList->MapAction(FGridlyLocalizationTargetEditorCommands::Get().CompileLocResForTargetFromGridly,
+			FExecuteAction::CreateRaw(this, &FGridlyLocalizationServiceProvider::CompileLocResForTargetFromGridly,
+				LocalizationTarget, bIsTargetSet));
+		ToolbarBuilder.AddToolBarButton(
+			FGridlyLocalizationTargetEditorCommands::Get().CompileLocResForTargetFromGridly, NAME_None,
+			TAttribute<FText>(), TAttribute<FText>(), FSlateIcon(FGridlyStyle::GetStyleSetName(),
+				"Gridly.ImportAction"));
 	}
 }
 #endif	  // LOCALIZATION_SERVICES_WITH_SLATE
@@ -304,6 +409,9 @@ void FGridlyLocalizationServiceProvider::ImportAllCulturesForTargetFromGridly(
 
 	if (!bIsTargetSet && MessageReturn == EAppReturnType::Yes)
 	{
+		// Picks up cultures added to the targets since the last import
+		FGridlyCultureConverter::InvalidateTargetCultures();
+
 		TArray<FString> Cultures;
 
 		for (int i = 0; i < LocalizationTarget->Settings.SupportedCulturesStatistics.Num(); i++)
@@ -318,16 +426,20 @@ void FGridlyLocalizationServiceProvider::ImportAllCulturesForTargetFromGridly(
 
 		CurrentCultureDownloads.Append(Cultures);
 		SuccessfulDownloads = 0;
+		ChangedCulturePoFiles.Reset();
+		DownloadedCulturePoFiles.Reset();
+		bImportingToArchives = GetDefault<UGridlyGameSettings>()->bImportDirectlyToArchives;
 
 		const float AmountOfWork = CurrentCultureDownloads.Num();
 		ImportAllCulturesForTargetFromGridlySlowTask = MakeShareable(new FScopedSlowTask(AmountOfWork,
 			LOCTEXT("ImportAllCulturesForTargetFromGridlyText", "Importing all cultures for target from Gridly")));
 
-		ImportAllCulturesForTargetFromGridlySlowTask->MakeDialog();
+		ImportAllCulturesForTargetFromGridlySlowTask->MakeDialog(true);
+
+		TArray<TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>> DownloadOperations;
 
 		for (const FString& CultureName : Cultures)
 		{
-			ILocalizationServiceProvider& Provider = ILocalizationServiceModule::Get().GetProvider();
 			TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe> DownloadTargetFileOp =
 				ILocalizationServiceOperation::Create<FDownloadLocalizationTargetFile>();
 			DownloadTargetFileOp->SetInTargetGuid(LocalizationTarget->Settings.Guid);
@@ -347,20 +459,55 @@ void FGridlyLocalizationServiceProvider::ImportAllCulturesForTargetFromGridly(
 				{
 					PlatformFile.DeleteFile(*Path);
 					UE_LOG(LogGridlyLocalizationServiceProvider, Warning, TEXT("Deleted empty file: %s"), *Path);
+					CurrentCultureDownloads.Remove(CultureName);
 					continue;
 				}
 			}
 
-			auto OperationCompleteDelegate = FLocalizationServiceOperationComplete::CreateRaw(this,
-				&FGridlyLocalizationServiceProvider::OnImportCultureForTargetFromGridly, bIsTargetSet);
-
-			Provider.Execute(DownloadTargetFileOp, TArray<FLocalizationServiceTranslationIdentifier>(),
-				ELocalizationServiceOperationConcurrency::Synchronous, OperationCompleteDelegate);
+			DownloadOperations.Add(DownloadTargetFileOp);
 
 			ImportAllCulturesForTargetFromGridlySlowTask->EnterProgressFrame(1.f);
 		}
 
-		ImportAllCulturesForTargetFromGridlySlowTask.Reset();
+		// All cultures are served from a single download of the import views
+
+		auto OperationCompleteDelegate = FLocalizationServiceOperationComplete::CreateRaw(this,
+			&FGridlyLocalizationServiceProvider::OnImportCultureForTargetFromGridly, bIsTargetSet);
+
+		FImportDownloadedTexts ImportTexts;
+		if (bImportingToArchives)
+		{
+			// Skips the .po files and the import commandlet, the texts are already in memory
+			ImportTexts = [LocalizationTarget, Cultures](const TArray<FPolyglotTextData>& PolyglotTextDatas, FText& OutError)
+			{
+				if (!LocalizationTarget.IsValid())
+				{
+					OutError = LOCTEXT("ImportTargetRemovedText", "The localization target was removed during the import");
+					return false;
+				}
+
+				TArray<FString> ChangedCultures;
+				if (!FGridlyLocalizedText::ImportPolyglotTextDatasToArchives(LocalizationTarget.Get(), PolyglotTextDatas, Cultures,
+					ChangedCultures, OutError))
+				{
+					return false;
+				}
+
+				if (ChangedCultures.Num() > 0)
+				{
+					LocalizationTarget->UpdateStatusFromConflictReport();
+				}
+				return true;
+			};
+		}
+
+		ExecuteDownloads(DownloadOperations, OperationCompleteDelegate, ImportTexts);
+
+		// The dialog stays open until the download completes, so it can be cancelled
+		if (DownloadOperations.Num() == 0)
+		{
+			ImportAllCulturesForTargetFromGridlySlowTask.Reset();
+		}
 	}
 }
 
@@ -376,9 +523,37 @@ void FGridlyLocalizationServiceProvider::OnImportCultureForTargetFromGridly(cons
 
 	CurrentCultureDownloads.Remove(DownloadLocalizationTargetOp->GetInLocale());
 
+	if (CurrentCultureDownloads.Num() == 0)
+	{
+		ImportAllCulturesForTargetFromGridlySlowTask.Reset();
+	}
+
 	if (Result == ELocalizationServiceOperationCommandResult::Succeeded)
 	{
 		SuccessfulDownloads++;
+
+		// Imports straight to the archives are already done and have no .po file
+		if (!bImportingToArchives)
+		{
+			const FString PoFilePath = FPaths::ConvertRelativePathToFull(
+				FPaths::ProjectDir() / DownloadLocalizationTargetOp->GetInRelativeOutputFilePathAndName());
+
+			DownloadedCulturePoFiles.Add(DownloadLocalizationTargetOp->GetInLocale(), PoFilePath);
+
+			if (FGridlyImportedPoFiles::HasChanged(PoFilePath))
+			{
+				ChangedCulturePoFiles.Add(DownloadLocalizationTargetOp->GetInLocale(), PoFilePath);
+			}
+			else
+			{
+				UE_LOG(LogGridlyEditor, Log, TEXT("%s hasn't changed since it was last imported, skipping it"),
+					*DownloadLocalizationTargetOp->GetInLocale());
+			}
+		}
+	}
+	else if (Result == ELocalizationServiceOperationCommandResult::Cancelled)
+	{
+		UE_LOG(LogGridlyEditor, Log, TEXT("Import of %s from Gridly was cancelled"), *DownloadLocalizationTargetOp->GetInLocale());
 	}
 	else
 	{
@@ -387,7 +562,15 @@ void FGridlyLocalizationServiceProvider::OnImportCultureForTargetFromGridly(cons
 		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(ErrorMessage.ToString()));
 	}
 
-	if (CurrentCultureDownloads.Num() == 0 && SuccessfulDownloads > 0)
+	if (CurrentCultureDownloads.Num() == 0 && SuccessfulDownloads > 0 && bImportingToArchives)
+	{
+		UE_LOG(LogGridlyEditor, Log, TEXT("Imported %d cultures from Gridly to the archives"), SuccessfulDownloads);
+	}
+	else if (CurrentCultureDownloads.Num() == 0 && SuccessfulDownloads > 0 && ChangedCulturePoFiles.Num() == 0)
+	{
+		UE_LOG(LogGridlyEditor, Log, TEXT("No culture has changed on Gridly since the last import, nothing to import"));
+	}
+	else if (CurrentCultureDownloads.Num() == 0 && SuccessfulDownloads > 0)
 	{
 		const FString TargetName = FPaths::GetBaseFilename(DownloadLocalizationTargetOp->GetInRelativeOutputFilePathAndName());
 
@@ -403,9 +586,36 @@ void FGridlyLocalizationServiceProvider::OnImportCultureForTargetFromGridly(cons
 		if (!bIsTargetSet)
 		{
 
-			//here we call the gather
-			LocalizationCommandletTasks::ImportTextForTarget(MainFrameParentWindow.ToSharedRef(), Target,
-				FPaths::GetPath(FPaths::GetPath(AbsoluteFilePathAndName)));
+			TArray<FString> PoFilePaths;
+			bool bImported = true;
+
+			// Every import spawns a commandlet, so a single culture is imported on its own and anything more in one go
+			if (ChangedCulturePoFiles.Num() > 1)
+			{
+				//here we call the gather
+				bImported = LocalizationCommandletTasks::ImportTextForTarget(MainFrameParentWindow.ToSharedRef(), Target,
+					FPaths::GetPath(FPaths::GetPath(AbsoluteFilePathAndName)));
+
+				// The unchanged cultures have been imported again too
+				DownloadedCulturePoFiles.GenerateValueArray(PoFilePaths);
+			}
+			else
+			{
+				for (const TPair<FString, FString>& Pair : ChangedCulturePoFiles)
+				{
+					bImported = LocalizationCommandletTasks::ImportTextForCulture(MainFrameParentWindow.ToSharedRef(), Target,
+						Pair.Key, TOptional<FString>(Pair.Value));
+				}
+				ChangedCulturePoFiles.GenerateValueArray(PoFilePaths);
+			}
+
+			if (bImported)
+			{
+				FGridlyImportedPoFiles::MarkImported(PoFilePaths);
+			}
+
+			ChangedCulturePoFiles.Reset();
+			DownloadedCulturePoFiles.Reset();
 
 			Target->UpdateWordCountsFromCSV();
 			Target->UpdateStatusFromConflictReport();
@@ -417,15 +627,14 @@ void FGridlyLocalizationServiceProvider::OnImportCultureForTargetFromGridly(cons
 }
 
 TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateExportRequest(const TArray<FPolyglotTextData>& PolyglotTextDatas,
-	const TSharedPtr<FLocTextHelper>& LocTextHelperPtr, bool bIncludeTargetTranslations)
+	const FGridlySettingsSnapshot& Settings, const TSharedPtr<FLocTextHelper>& LocTextHelperPtr, bool bIncludeTargetTranslations)
 {
 	FString JsonString;
-	FGridlyExporter::ConvertToJson(PolyglotTextDatas, bIncludeTargetTranslations, LocTextHelperPtr, JsonString);
+	FGridlyExporter::ConvertToJson(PolyglotTextDatas, Settings, bIncludeTargetTranslations, LocTextHelperPtr, JsonString);
 	UE_LOG(LogGridlyEditor, Log, TEXT("Creating export request with %d entries"), PolyglotTextDatas.Num());
 
-	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
-	const FString ApiKey = GameSettings->ExportApiKey;
-	const FString ViewId = GameSettings->ExportViewId;
+	const FString ApiKey = Settings.ExportApiKey;
+	const FString ViewId = Settings.ExportViewId;
 
 	FStringFormatNamedArguments Args;
 	Args.Add(TEXT("ViewId"), *ViewId);
@@ -469,9 +678,9 @@ void FGridlyLocalizationServiceProvider::ExportNativeCultureForTargetToGridly(
 
 void FGridlyLocalizationServiceProvider::OnExportNativeCultureForTargetToGridly(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess)
 {
-	UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+	InFlightExportRequests.Remove(HttpRequestPtr);
 
-	const bool bSyncRecords = GameSettings->bSyncRecords;
+	const bool bSyncRecords = GetExportSettings().bSyncRecords;
 	if (bSuccess)
 	{
 		if (HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok || HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Created)
@@ -489,6 +698,7 @@ void FGridlyLocalizationServiceProvider::OnExportNativeCultureForTargetToGridly(
 			TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> NextRequest;
 			if (ExportFromTargetRequestQueue.Dequeue(NextRequest))
 			{
+				InFlightExportRequests.Add(NextRequest);
 				NextRequest->ProcessRequest();
 			}
 			else
@@ -572,6 +782,8 @@ void FGridlyLocalizationServiceProvider::ExportTranslationsForTargetToGridly(TWe
 
 void FGridlyLocalizationServiceProvider::OnExportTranslationsForTargetToGridly(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess)
 {
+	InFlightExportRequests.Remove(HttpRequestPtr);
+
 	if (bSuccess)
 	{
 		if (HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok || HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Created)
@@ -589,6 +801,7 @@ void FGridlyLocalizationServiceProvider::OnExportTranslationsForTargetToGridly(F
 			TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> NextRequest;
 			if (ExportFromTargetRequestQueue.Dequeue(NextRequest))
 			{
+				InFlightExportRequests.Add(NextRequest);
 				NextRequest->ProcessRequest();
 			}
 			else
@@ -646,6 +859,11 @@ void FGridlyLocalizationServiceProvider::ExportForTargetToGridly(ULocalizationTa
 	UERecords.Empty();
 	GridlyRecords.Empty();
 
+	// Picks up cultures added to the targets since the last export
+	FGridlyCultureConverter::InvalidateTargetCultures();
+
+	// The whole export, including the record sync that follows it, uses the settings as they are now
+	ExportSettings = FGridlySettingsSnapshot::Capture();
 
 	if (FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(InLocalizationTarget, PolyglotTextDatas, LocTextHelperPtr))
 	{
@@ -653,10 +871,10 @@ void FGridlyLocalizationServiceProvider::ExportForTargetToGridly(ULocalizationTa
 
 		while (PolyglotTextDatas.Num() > 0)
 		{
-			const size_t ChunkSize = FMath::Min(GetMutableDefault<UGridlyGameSettings>()->ExportMaxRecordsPerRequest, PolyglotTextDatas.Num());
+			const size_t ChunkSize = FMath::Min(ExportSettings->ExportMaxRecordsPerRequest, PolyglotTextDatas.Num());
 			const TArray<FPolyglotTextData> ChunkPolyglotTextDatas(PolyglotTextDatas.GetData(), ChunkSize);
 			PolyglotTextDatas.RemoveAt(0, ChunkSize);
-			const auto HttpRequest = CreateExportRequest(ChunkPolyglotTextDatas, LocTextHelperPtr, bIncTargetTranslation);
+			const auto HttpRequest = CreateExportRequest(ChunkPolyglotTextDatas, *ExportSettings, LocTextHelperPtr, bIncTargetTranslation);
 			HttpRequest->OnProcessRequestComplete() = ReqDelegate;
 			ExportFromTargetRequestQueue.Enqueue(HttpRequest);
 			for (int i = 0; i < ChunkPolyglotTextDatas.Num(); i++)
@@ -678,10 +896,11 @@ void FGridlyLocalizationServiceProvider::ExportForTargetToGridly(ULocalizationTa
 			if (!IsRunningCommandlet())
 			{
 				ExportForTargetToGridlySlowTask = MakeShareable(new FScopedSlowTask(static_cast<float>(TotalRequests), SlowTaskText));
-				ExportForTargetToGridlySlowTask->MakeDialog();
+				ExportForTargetToGridlySlowTask->MakeDialog(true);
 			}
 
 			bExportRequestInProgress = true;
+			InFlightExportRequests.Add(HttpRequest);
 			HttpRequest->ProcessRequest();
 		}
 	}
@@ -702,9 +921,9 @@ void FGridlyLocalizationServiceProvider::FetchGridlyCSV()
 	// Set the flag to true at the beginning of the process
 	bHasDeletesPending = true;
 	
-	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
-	const FString ApiKey = GameSettings->ExportApiKey;
-	const FString ViewId = GameSettings->ExportViewId;
+	const FGridlySettingsSnapshot& Settings = GetExportSettings();
+	const FString ApiKey = Settings.ExportApiKey;
+	const FString ViewId = Settings.ExportViewId;
 	// URL for fetching the CSV from Gridly
 	FStringFormatNamedArguments Args;
 	Args.Add(TEXT("ViewId"), *ViewId);
@@ -723,11 +942,14 @@ void FGridlyLocalizationServiceProvider::FetchGridlyCSV()
 	HttpRequest->OnProcessRequestComplete().BindRaw(this, &FGridlyLocalizationServiceProvider::OnGridlyCSVResponseReceived);
 
 	// Send the request
+	InFlightExportRequests.Add(HttpRequest);
 	HttpRequest->ProcessRequest();
 }
 
 void FGridlyLocalizationServiceProvider::OnGridlyCSVResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
+	InFlightExportRequests.Remove(Request);
+
 	if (!bWasSuccessful || !Response.IsValid())
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to fetch Gridly CSV"));
@@ -745,7 +967,7 @@ void FGridlyLocalizationServiceProvider::OnGridlyCSVResponseReceived(FHttpReques
 void FGridlyLocalizationServiceProvider::ParseCSVAndCreateRecords(const FString& CSVContent)
 {
 	// Don't reset the flag here, it will be reset in DeleteRecordsFromGridly if there are no records to delete
-	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+	const FGridlySettingsSnapshot& Settings = GetExportSettings();
 	
 	const TCHAR QuoteChar = TEXT('"');
 	const TCHAR Delimiter = TEXT(',');
@@ -967,7 +1189,7 @@ void FGridlyLocalizationServiceProvider::ParseCSVAndCreateRecords(const FString&
 			UE_LOG(LogGridlyLocalizationServiceProvider, Log, TEXT("No match found for GridlyRecord: ID = %s, Path = %s. Adding to delete list."), *GridlyRecord.Id, *GridlyRecord.Path);
 
 			// If the path is empty or used combine namespace and ID is false, we only add the record ID
-			if (GridlyRecord.Path.Len() == 0 || !GameSettings->bUseCombinedNamespaceId)
+			if (GridlyRecord.Path.Len() == 0 || !Settings.bUseCombinedNamespaceId)
 			{
 				RecordsToDelete.Add(GridlyRecord.Id);
 			}
@@ -1066,9 +1288,9 @@ void FGridlyLocalizationServiceProvider::DeleteRecordsFromGridly(const TArray<FS
 		// Log the JSON payload for debugging
 		UE_LOG(LogGridlyLocalizationServiceProvider, Log, TEXT("JSON Payload: %s"), *JsonPayload);
 
-		const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
-		const FString ApiKey = GameSettings->ExportApiKey;
-		const FString ViewId = GameSettings->ExportViewId;
+		const FGridlySettingsSnapshot& Settings = GetExportSettings();
+		const FString ApiKey = Settings.ExportApiKey;
+		const FString ViewId = Settings.ExportViewId;
 
 		FStringFormatNamedArguments Args;
 		Args.Add(TEXT("ViewId"), *ViewId);
@@ -1084,6 +1306,7 @@ void FGridlyLocalizationServiceProvider::DeleteRecordsFromGridly(const TArray<FS
 		// Bind the response handler for each batch
 		HttpRequest->OnProcessRequestComplete().BindRaw(this, &FGridlyLocalizationServiceProvider::OnDeleteRecordsResponse);
 
+		InFlightExportRequests.Add(HttpRequest);
 		HttpRequest->ProcessRequest();
 
 		// Track the number of records requested for deletion
@@ -1095,6 +1318,8 @@ void FGridlyLocalizationServiceProvider::DeleteRecordsFromGridly(const TArray<FS
 
 void FGridlyLocalizationServiceProvider::OnDeleteRecordsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
+	InFlightExportRequests.Remove(Request);
+
 	if (!Request.IsValid() || !Response.IsValid())
 	{
 		UE_LOG(LogGridlyLocalizationServiceProvider, Error, TEXT("Invalid HTTP request or response."));
@@ -1157,6 +1382,90 @@ bool FGridlyLocalizationServiceProvider::HasDeleteRequestsPending() const
 	return bHasDeletesPending;
 }
 
+const FGridlySettingsSnapshot& FGridlyLocalizationServiceProvider::GetExportSettings()
+{
+	// FetchGridlyCSV can also be called on its own, without an export having captured the settings
+	if (!ExportSettings.IsValid())
+	{
+		ExportSettings = FGridlySettingsSnapshot::Capture();
+	}
+
+	return *ExportSettings;
+}
+
+void FGridlyLocalizationServiceProvider::CancelExport()
+{
+	if (!HasRequestsPending() && !bHasDeletesPending && InFlightExportRequests.Num() == 0)
+	{
+		return;
+	}
+
+	UE_LOG(LogGridlyEditor, Log, TEXT("Cancelled export to Gridly"));
+
+	// Queued requests are never sent, and the ones in flight are aborted without reporting back
+
+	ExportFromTargetRequestQueue.Empty();
+
+	for (const FHttpRequestPtr& HttpRequest : InFlightExportRequests)
+	{
+		HttpRequest->OnProcessRequestComplete().Unbind();
+		HttpRequest->CancelRequest();
+	}
+	InFlightExportRequests.Empty();
+
+	bExportRequestInProgress = false;
+	bHasDeletesPending = false;
+	CompletedBatches = 0;
+	TotalBatchesToProcess = 0;
+
+	UERecords.Empty();
+	GridlyRecords.Empty();
+
+	ExportForTargetToGridlySlowTask.Reset();
+}
+
+void FGridlyLocalizationServiceProvider::CompileLocResForTargetFromGridly(TWeakObjectPtr<ULocalizationTarget> LocalizationTarget,
+	bool bIsTargetSet)
+{
+	check(LocalizationTarget.IsValid());
+
+	if (bIsTargetSet)
+	{
+		return;
+	}
+
+	// Picks up cultures added to the targets since the last import
+	FGridlyCultureConverter::InvalidateTargetCultures();
+
+	UGridlyTask_DownloadLocalizedTexts* Task = UGridlyTask_DownloadLocalizedTexts::DownloadLocalizedTextsPooled(nullptr);
+
+	Task->OnSuccessDelegate.BindLambda([LocalizationTarget](const TArray<FPolyglotTextData>& PolyglotTextDatas)
+	{
+		if (!LocalizationTarget.IsValid())
+		{
+			return;
+		}
+
+		FText Error;
+		if (!FGridlyLocResCompiler::CompileTarget(LocalizationTarget.Get(), PolyglotTextDatas, Error))
+		{
+			UE_LOG(LogGridlyEditor, Error, TEXT("%s"), *Error.ToString());
+			FMessageDialog::Open(EAppMsgType::Ok, Error);
+		}
+	});
+
+	Task->OnFailDelegate.BindLambda([](const TArray<FPolyglotTextData>& PolyglotTextDatas, const FGridlyResult& Error)
+	{
+		if (!Error.bCancelled)
+		{
+			UE_LOG(LogGridlyEditor, Error, TEXT("%s"), *Error.Message);
+			FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Error.Message));
+		}
+	});
+
+	Task->Activate();
+}
+
 void FGridlyLocalizationServiceProvider::DownloadSourceChangesFromGridly(TWeakObjectPtr<ULocalizationTarget> LocalizationTarget, bool bIsTargetSet)
 {
 	check(LocalizationTarget.IsValid());
@@ -1266,7 +1575,8 @@ void FGridlyLocalizationServiceProvider::OnDownloadSourceChangesFromGridly(FHttp
 
 	// Group records by namespace (path column)
 	TMap<FString, TArray<FGridlySourceRecord>> NamespaceRecords;
-	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+	const FGridlySettingsSnapshotRef Settings = FGridlySettingsSnapshot::Capture();
+	const FGridlyCultureConverter CultureConverter(*Settings, TArray<FString>());
 
 	for (const TSharedPtr<FJsonValue>& RecordValue : RecordsArray)
 	{
@@ -1308,13 +1618,13 @@ void FGridlyLocalizationServiceProvider::OnDownloadSourceChangesFromGridly(FHttp
 						(*CellObject)->TryGetStringField(FString(TEXT("value")), Value))
 					{
 						// Check if this is the source language column
-						if (ColumnId.StartsWith(GameSettings->SourceLanguageColumnIdPrefix))
+						if (ColumnId.StartsWith(Settings->SourceLanguageColumnIdPrefix))
 						{
-							const FString GridlyCulture = ColumnId.RightChop(GameSettings->SourceLanguageColumnIdPrefix.Len());
+							const FString GridlyCulture = ColumnId.RightChop(Settings->SourceLanguageColumnIdPrefix.Len());
 							FString Culture;
 							
 							// Convert Gridly culture to UE culture
-							if (FGridlyCultureConverter::ConvertFromGridly(TArray<FString>(), GridlyCulture, Culture))
+							if (CultureConverter.FromGridly(GridlyCulture, Culture))
 							{
 								// Check if this matches our native culture
 								if (Culture == CurrentSourceDownloadCulture)
@@ -1335,7 +1645,7 @@ void FGridlyLocalizationServiceProvider::OnDownloadSourceChangesFromGridly(FHttp
 			FString Namespace = SourceRecord.Path;
 			
 			// Handle combined namespace key format
-			if (GameSettings->bUseCombinedNamespaceId)
+			if (Settings->bUseCombinedNamespaceId)
 			{
 				FString Key;
 				if (SourceRecord.RecordId.Split(TEXT(","), &Namespace, &Key))
@@ -7,12 +7,17 @@
 #include "ILocalizationServiceOperation.h"
 #include "ILocalizationServiceProvider.h"
 #include "ILocalizationServiceState.h"
+#include "LocalizationServiceOperations.h"
 #include "Interfaces/IHttpRequest.h"
+#include "Internationalization/PolyglotTextData.h"
 #include <string>
 #include <fstream>
 #include <iostream>
 
 
+class UGridlyTask_DownloadLocalizedTexts;
+struct FGridlySettingsSnapshot;
+
 class FGridlyLocalizationServiceProvider final : public ILocalizationServiceProvider
 {
 
@@ -81,10 +86,28 @@ public:
 		TSharedRef<FUICommandList> CommandList);
 #endif	  // LOCALIZATION_SERVICES_WITH_SLATE
 
+	// Imports downloaded texts in place of writing .po files. Returns false and sets the error on failure
+	typedef TFunction<bool(const TArray<FPolyglotTextData>&, FText&)> FImportDownloadedTexts;
+
+	// Called with the downloaded texts before they are imported, so other steps can use them without downloading again
+	typedef TFunction<void(const TArray<FPolyglotTextData>&)> FOnTextsDownloaded;
+
+	// Downloads the import views once and writes the .po file of every given operation from that single result.
+	// When ImportTexts is set, it's given the downloaded texts instead and no .po file is written
+	void ExecuteDownloads(const TArray<TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>>& DownloadOperations,
+		const FLocalizationServiceOperationComplete& InOperationCompleteDelegate, const FImportDownloadedTexts& ImportTexts = nullptr,
+		const FOnTextsDownloaded& OnTextsDownloaded = nullptr);
+
 	// functions to run export/import from commandlet
 	FHttpRequestCompleteDelegate CreateExportNativeCultureDelegate();
 	bool HasRequestsPending() const;
 
+	// Drops the queued export requests and aborts the export, CSV and delete requests in flight
+	void CancelExport();
+
+	// Cancels every download started by ExecuteDownloads
+	void CancelDownloads();
+
 	void ExportForTargetToGridly(ULocalizationTarget* LocalizationTarget, FHttpRequestCompleteDelegate& ReqDelegate, const FText& SlowTaskText, bool bIncTargetTranslation = false);
 
 	// New functions for fetching and parsing CSV from Gridly
@@ -100,7 +123,18 @@ private:
 		ELocalizationServiceOperationCommandResult::Type Result, bool bIsTargetSet);
 	TSharedPtr<FScopedSlowTask> ImportAllCulturesForTargetFromGridlySlowTask;
 	TArray<FString> CurrentCultureDownloads;
+	TMap<const ILocalizationServiceOperation*, TWeakObjectPtr<UGridlyTask_DownloadLocalizedTexts>> ActiveDownloadTasks;
+	void RemoveActiveDownloads(const TArray<TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe>>& DownloadOperations);
 	int SuccessfulDownloads;
+
+	// Culture -> downloaded .po file, for the cultures whose file changed since it was last imported
+	TMap<FString, FString> ChangedCulturePoFiles;
+
+	// Culture -> downloaded .po file, for every culture downloaded by the current import
+	TMap<FString, FString> DownloadedCulturePoFiles;
+
+	// Set when the current import writes straight to the archives, see UGridlyGameSettings::bImportDirectlyToArchives
+	bool bImportingToArchives = false;
 	size_t ExportForTargetEntriesDeleted = 0;
 
 
@@ -110,6 +144,11 @@ private:
 	TSharedPtr<FScopedSlowTask> ExportForTargetToGridlySlowTask;
 	TQueue<TSharedPtr<IHttpRequest, ESPMode::ThreadSafe>> ExportFromTargetRequestQueue;
 	bool bExportRequestInProgress = false;
+	TArray<FHttpRequestPtr> InFlightExportRequests;
+
+	// Captured when an export starts and kept for the record sync that follows it
+	TSharedPtr<const FGridlySettingsSnapshot, ESPMode::ThreadSafe> ExportSettings;
+	const FGridlySettingsSnapshot& GetExportSettings();
 
 	void ExportNativeCultureForTargetToGridly(TWeakObjectPtr<ULocalizationTarget> LocalizationTarget, bool bIsTargetSet);
 	void OnExportNativeCultureForTargetToGridly(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess);
@@ -119,6 +158,9 @@ private:
 	void ExportTranslationsForTargetToGridly(TWeakObjectPtr<ULocalizationTarget> LocalizationTarget, bool bIsTargetSet);
 	void OnExportTranslationsForTargetToGridly(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess);
 
+	// Compile from Gridly
+	void CompileLocResForTargetFromGridly(TWeakObjectPtr<ULocalizationTarget> LocalizationTarget, bool bIsTargetSet);
+
 	// Download source changes
 	void DownloadSourceChangesFromGridly(TWeakObjectPtr<ULocalizationTarget> LocalizationTarget, bool bIsTargetSet);
 	void OnDownloadSourceChangesFromGridly(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess);
@@ -9,8 +9,8 @@
 #include "LocTextHelper.h"
 #include "Internationalization/PolyglotTextData.h"
 
-bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* LocalizationTarget,
-	TArray<FPolyglotTextData>& OutPolyglotTextDatas, TSharedPtr<FLocTextHelper>& LocTextHelper)
+bool FGridlyLocalizedText::LoadLocTextHelper(ULocalizationTarget* LocalizationTarget, const TArray<FString>& Cultures,
+	TSharedPtr<FLocTextHelper>& OutLocTextHelper, FText& OutError)
 {
 	const FString ConfigFilePath = LocalizationConfigurationScript::GetGatherTextConfigPath(LocalizationTarget);
 	const FString SectionName = TEXT("CommonSettings");
@@ -23,7 +23,7 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 	FString SourcePath;
 	if (!GConfig->GetString(*SectionName, TEXT("SourcePath"), SourcePath, ConfigFilePath))
 	{
-		UE_LOG(LogGridlyEditor, Error, TEXT("No source path specified."));
+		OutError = FText::FromString(TEXT("No source path specified."));
 		return false;
 	}
 
@@ -31,7 +31,7 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 	FString DestinationPath;
 	if (!GConfig->GetString(*SectionName, TEXT("DestinationPath"), DestinationPath, ConfigFilePath))
 	{
-		UE_LOG(LogGridlyEditor, Error, TEXT("No destination path specified."));
+		OutError = FText::FromString(TEXT("No destination path specified."));
 		return false;
 	}
 
@@ -39,7 +39,7 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 	FString ManifestName;
 	if (!GConfig->GetString(*SectionName, TEXT("ManifestName"), ManifestName, ConfigFilePath))
 	{
-		UE_LOG(LogGridlyEditor, Error, TEXT("No manifest name specified."));
+		OutError = FText::FromString(TEXT("No manifest name specified."));
 		return false;
 	}
 
@@ -47,7 +47,7 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 	FString ArchiveName;
 	if (!GConfig->GetString(*SectionName, TEXT("ArchiveName"), ArchiveName, ConfigFilePath))
 	{
-		UE_LOG(LogGridlyEditor, Error, TEXT("No archive name specified."));
+		OutError = FText::FromString(TEXT("No archive name specified."));
 		return false;
 	}
 
@@ -67,22 +67,70 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 		DestinationPath = FPaths::Combine(*FPaths::ProjectDir(), *DestinationPath);
 	}
 
+	// Load the manifest and all archives
+	OutLocTextHelper = MakeShareable(new FLocTextHelper(SourcePath, ManifestName, ArchiveName, NativeCulture, Cultures, nullptr));
+	return OutLocTextHelper->LoadAll(ELocTextHelperLoadFlags::LoadOrCreate, &OutError);
+}
+
+FString FGridlyLocalizedText::GetGridlyNamespace(const FManifestEntry& ManifestEntry, const FManifestContext& Context)
+{
+	FString SourceNamespace = ManifestEntry.Namespace.GetString();
+	if (SourceNamespace.IsEmpty())
+	{
+		// Extract substring from Context.SourceLocation
+		FString SourceLocation = Context.SourceLocation;
+		int32 LastSlashPos;
+		if (SourceLocation.FindLastChar('/', LastSlashPos))
+		{
+			int32 FirstDotPos = SourceLocation.Find(TEXT("."), ESearchCase::IgnoreCase, ESearchDir::FromStart, LastSlashPos);
+			if (FirstDotPos != INDEX_NONE && FirstDotPos > LastSlashPos)
+			{
+				SourceNamespace = "blueprints/" + SourceLocation.Mid(LastSlashPos + 1, FirstDotPos - LastSlashPos - 1);
+			}
+		}
+		else
+		{
+			// Handle case where extraction fails
+			SourceNamespace = ""; // Or any appropriate fallback
+		}
+	}
+	return SourceNamespace;
+}
+
+FGridlyLocalizedText::FTextsByGridlyKey FGridlyLocalizedText::MapTextsByGridlyKey(const TArray<FPolyglotTextData>& PolyglotTextDatas)
+{
+	FTextsByGridlyKey GridlyTexts;
+	GridlyTexts.Reserve(PolyglotTextDatas.Num());
+	for (const FPolyglotTextData& PolyglotTextData : PolyglotTextDatas)
+	{
+		GridlyTexts.Add(MakeTuple(FLocKey(PolyglotTextData.GetNamespace()), FLocKey(PolyglotTextData.GetKey())), &PolyglotTextData);
+	}
+	return GridlyTexts;
+}
+
+bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* LocalizationTarget,
+	TArray<FPolyglotTextData>& OutPolyglotTextDatas, TSharedPtr<FLocTextHelper>& LocTextHelper)
+{
+	const int NativeCultureIndex = LocalizationTarget->Settings.NativeCultureIndex;
+	FString NativeCulture = LocalizationTarget->Settings.SupportedCulturesStatistics[NativeCultureIndex].CultureName;
+
 	const TArray<FString> CulturesToGenerate = FGridlyCultureConverter::GetTargetCultures();
 
-	// Load the manifest and all archives
-	LocTextHelper = MakeShareable(new FLocTextHelper(SourcePath, ManifestName, ArchiveName, NativeCulture, CulturesToGenerate, nullptr));
-	//FLocTextHelper LocTextHelper(SourcePath, ManifestName, ArchiveName, NativeCulture, CulturesToGenerate, nullptr);
 	{
 		FText LoadError;
-		if (!LocTextHelper->LoadAll(ELocTextHelperLoadFlags::LoadOrCreate, &LoadError))
+		if (!LoadLocTextHelper(LocalizationTarget, CulturesToGenerate, LocTextHelper, LoadError))
 		{
 			UE_LOG(LogGridlyEditor, Error, TEXT("%s"), *LoadError.ToString());
 			return false;
 		}
 	}
 
+	// Translations are matched to their source text by key. The manifest keys are FLocKeys, which carry their hash, so the
+	// lookup is a map find instead of a scan of every text gathered so far
+	TMap<FLocKey, int32> KeyIndices;
+
 	LocTextHelper->EnumerateSourceTexts(
-		[&LocTextHelper, &OutPolyglotTextDatas, &NativeCulture](TSharedRef<FManifestEntry> InManifestEntry)
+		[&LocTextHelper, &OutPolyglotTextDatas, &NativeCulture, &KeyIndices](TSharedRef<FManifestEntry> InManifestEntry)
 		{
 			for (const FManifestContext& Context : InManifestEntry->Contexts)
 			{
@@ -91,33 +139,19 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 					Context.KeyMetadataObj, ELocTextExportSourceMethod::NativeText, InManifestEntry->Source, TranslationText, true);
 
 				const FString SourceKey = Context.Key.GetString();
-				FString SourceNamespace = InManifestEntry->Namespace.GetString();
-				if (SourceNamespace.IsEmpty())
-				{
-					// Extract substring from Context.SourceLocation
-					FString SourceLocation = Context.SourceLocation;
-					int32 LastSlashPos;
-					if (SourceLocation.FindLastChar('/', LastSlashPos))
-					{
-						int32 FirstDotPos = SourceLocation.Find(TEXT("."), ESearchCase::IgnoreCase, ESearchDir::FromStart, LastSlashPos);
-						if (FirstDotPos != INDEX_NONE && FirstDotPos > LastSlashPos)
-						{
-							SourceNamespace = "blueprints/" + SourceLocation.Mid(LastSlashPos + 1, FirstDotPos - LastSlashPos - 1);
-						}
-					}
-					else
-					{
-						// Handle case where extraction fails
-						SourceNamespace = ""; // Or any appropriate fallback
-					}
-				}
+				const FString SourceNamespace = GetGridlyNamespace(*InManifestEntry, Context);
 				//1047
 				//const FString SourceText = TranslationText.Text;
 				const FString SourceText = InManifestEntry->Source.Text;
 
-				FPolyglotTextData PolyglotTextData(ELocalizedTextSourceCategory::Game, SourceNamespace, SourceKey, SourceText,
-					NativeCulture);
-				OutPolyglotTextDatas.Add(PolyglotTextData);
+				const int32 Index = OutPolyglotTextDatas.Emplace(ELocalizedTextSourceCategory::Game, SourceNamespace, SourceKey,
+					SourceText, NativeCulture);
+
+				// The first text with a key receives its translations
+				if (!KeyIndices.Contains(Context.Key))
+				{
+					KeyIndices.Add(Context.Key, Index);
+				}
 			}
 			return true;
 		}, true);
@@ -130,16 +164,11 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 		if (CultureName != NativeCulture)
 		{
 			LocTextHelper->EnumerateTranslations(CultureName,
-				[&CultureName, &OutPolyglotTextDatas](TSharedRef<FArchiveEntry> InManifestEntry)
+				[&CultureName, &OutPolyglotTextDatas, &KeyIndices](TSharedRef<FArchiveEntry> InManifestEntry)
 				{
-					FPolyglotTextData* PolyglotTextData = OutPolyglotTextDatas.FindByPredicate(
-						[&InManifestEntry](const FPolyglotTextData& PolyglotTextData)
-						{
-							return PolyglotTextData.GetKey() == InManifestEntry->Key.GetString();
-						});
-					if (PolyglotTextData)
+					if (const int32* Index = KeyIndices.Find(InManifestEntry->Key))
 					{
-						PolyglotTextData->AddLocalizedString(CultureName, InManifestEntry->Translation.Text);
+						OutPolyglotTextDatas[*Index].AddLocalizedString(CultureName, InManifestEntry->Translation.Text);
 					}
 					return true;
 				}, true);
@@ -148,3 +177,121 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 
 	return true;
 }
+
+bool FGridlyLocalizedText::ImportPolyglotTextDatasToArchives(ULocalizationTarget* LocalizationTarget,
+	const TArray<FPolyglotTextData>& PolyglotTextDatas, const TArray<FString>& Cultures, TArray<FString>& OutChangedCultures,
+	FText& OutError, const bool bForce)
+{
+	OutChangedCultures.Reset();
+
+	const int NativeCultureIndex = LocalizationTarget->Settings.NativeCultureIndex;
+	const FString NativeCulture = LocalizationTarget->Settings.SupportedCulturesStatistics[NativeCultureIndex].CultureName;
+
+	TSharedPtr<FLocTextHelper> LocTextHelper;
+	if (!LoadLocTextHelper(LocalizationTarget, FGridlyCultureConverter::GetTargetCultures(), LocTextHelper, OutError))
+	{
+		return false;
+	}
+
+	// Texts are matched to the manifest by the namespace they were exported with, like the locres compiler does, so a text
+	// without a namespace of its own is found under its blueprints/{Asset} namespace
+
+	struct FManifestText
+	{
+		const FPolyglotTextData* PolyglotTextData;
+		TSharedRef<FManifestEntry> ManifestEntry;
+		const FManifestContext* Context;
+	};
+
+	TArray<FManifestText> ManifestTexts;
+	{
+		const FTextsByGridlyKey GridlyTexts = MapTextsByGridlyKey(PolyglotTextDatas);
+		LocTextHelper->EnumerateSourceTexts([&GridlyTexts, &ManifestTexts](TSharedRef<FManifestEntry> ManifestEntry)
+		{
+			for (const FManifestContext& Context : ManifestEntry->Contexts)
+			{
+				const FLocKey GridlyNamespace(GetGridlyNamespace(*ManifestEntry, Context));
+				if (const FPolyglotTextData* const* GridlyText = GridlyTexts.Find(MakeTuple(GridlyNamespace, Context.Key)))
+				{
+					ManifestTexts.Add(FManifestText{*GridlyText, ManifestEntry, &Context});
+				}
+			}
+			return true;
+		}, true);
+	}
+
+	const int32 NumMissing = FMath::Max(0, PolyglotTextDatas.Num() - ManifestTexts.Num());
+	if (NumMissing > 0)
+	{
+		UE_LOG(LogGridlyEditor, Log, TEXT("%d downloaded texts aren't in the manifest of %s and were skipped"), NumMissing,
+			*LocalizationTarget->Settings.Name);
+	}
+
+	for (const FString& Culture : Cultures)
+	{
+		if (!LocTextHelper->HasArchive(Culture))
+		{
+			UE_LOG(LogGridlyEditor, Warning, TEXT("No archive for %s in %s, skipping it"), *Culture, *LocalizationTarget->Settings.Name);
+			continue;
+		}
+
+		int32 NumUpdated = 0;
+
+		for (const FManifestText& ManifestText : ManifestTexts)
+		{
+			FString Translation;
+			if (!ManifestText.PolyglotTextData->GetLocalizedString(Culture, Translation) || Translation.IsEmpty())
+			{
+				continue;
+			}
+
+			// The archives use the namespace of the manifest, not the one the text was exported with
+			const TSharedRef<FManifestEntry>& ManifestEntry = ManifestText.ManifestEntry;
+			const FManifestContext* Context = ManifestText.Context;
+			const FLocKey& Namespace = ManifestEntry->Namespace;
+			const FLocKey& Key = Context->Key;
+
+			// Foreign archives are keyed by the native translation of a text, the same as the .po import
+			FLocItem Source = ManifestEntry->Source;
+			if (Culture != NativeCulture)
+			{
+				const TSharedPtr<FArchiveEntry> NativeEntry = LocTextHelper->FindTranslation(NativeCulture, Namespace, Key,
+					Context->KeyMetadataObj);
+				if (NativeEntry.IsValid())
+				{
+					Source = NativeEntry->Translation;
+				}
+			}
+
+			const TSharedPtr<FArchiveEntry> ExistingEntry = LocTextHelper->FindTranslation(Culture, Namespace, Key,
+				Context->KeyMetadataObj);
+			if (!bForce && ExistingEntry.IsValid() && ExistingEntry->Source.IsExactMatch(Source)
+				&& ExistingEntry->Translation.Text.Equals(Translation, ESearchCase::CaseSensitive))
+			{
+				continue;
+			}
+
+			if (LocTextHelper->ImportTranslation(Culture, Namespace, Key, Context->KeyMetadataObj, Source, FLocItem(Translation),
+				Context->bIsOptional))
+			{
+				NumUpdated++;
+			}
+		}
+
+		if (NumUpdated == 0 && !bForce)
+		{
+			UE_LOG(LogGridlyEditor, Log, TEXT("The archive of %s is up to date"), *Culture);
+			continue;
+		}
+
+		if (!LocTextHelper->SaveArchive(Culture, &OutError))
+		{
+			return false;
+		}
+
+		UE_LOG(LogGridlyEditor, Log, TEXT("Imported %d translations to the archive of %s"), NumUpdated, *Culture);
+		OutChangedCultures.Add(Culture);
+	}
+
+	return true;
+}
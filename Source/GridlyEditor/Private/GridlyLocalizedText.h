@@ -4,12 +4,40 @@
 
 #include "CoreMinimal.h"
 
+#include "Internationalization/LocKeyFuncs.h"
+#include "Internationalization/PolyglotTextData.h"
 #include "LocalizationTargetTypes.h"
 
 class FLocTextHelper;
+struct FManifestContext;
+struct FManifestEntry;
+
 class FGridlyLocalizedText
 {
 public:
+	// Downloaded texts by the namespace and key they were exported to Gridly with
+	typedef TMap<TTuple<FLocKey, FLocKey>, const FPolyglotTextData*> FTextsByGridlyKey;
+
 	static bool GetAllTextAsPolyglotTextDatas(ULocalizationTarget* LocalizationTarget,
 		TArray<FPolyglotTextData>& OutPolyglotTextDatas, TSharedPtr<FLocTextHelper>& LocTextHelper);
+
+	/**
+	 * Writes the translations of the given cultures straight to the .archive files of the target, like the import commandlet
+	 * does with .po files. Texts that aren't in the manifest and empty translations are skipped.
+	 * OutChangedCultures receives the cultures whose archive has been updated. With bForce, every translation is imported and
+	 * every archive saved, even if they already match
+	 */
+	static bool ImportPolyglotTextDatasToArchives(ULocalizationTarget* LocalizationTarget,
+		const TArray<FPolyglotTextData>& PolyglotTextDatas, const TArray<FString>& Cultures, TArray<FString>& OutChangedCultures,
+		FText& OutError, const bool bForce = false);
+
+	/** Loads the manifest and the archives of the given cultures */
+	static bool LoadLocTextHelper(ULocalizationTarget* LocalizationTarget, const TArray<FString>& Cultures,
+		TSharedPtr<FLocTextHelper>& OutLocTextHelper, FText& OutError);
+
+	/** The namespace a text is exported to Gridly with. Texts without one are given the name of the blueprint they come from */
+	static FString GetGridlyNamespace(const FManifestEntry& ManifestEntry, const FManifestContext& Context);
+
+	/** Finds the downloaded text of a manifest entry when looked up with GetGridlyNamespace and the key of the context */
+	static FTextsByGridlyKey MapTextsByGridlyKey(const TArray<FPolyglotTextData>& PolyglotTextDatas);
 };